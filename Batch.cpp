@@ -0,0 +1,634 @@
+#include "Batch.h"
+#include "Board.h"
+#include "FileIo.h"
+#include "LockstepSolver.h"
+#include "PuzzleFile.h"
+#include "SolutionCache.h"
+#include "ThreadPool.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace Solver
+{
+    //Room for every cell or a status word, plus the newline and a solution count, or a binary record
+    template <int BoxSize>
+    struct Results
+    {
+        static const int Size = BasicLineSolver<BoxSize>::ResultSize;
+        static_assert(BinaryFormat<BoxSize>::RecordSize <= (size_t)Size, "A binary record has to fit in a result slot");
+        //Puzzles read per parallel block, big enough that the slowest puzzle in a block barely matters
+        //Larger grids get fewer lines so a block takes about the same memory at every size
+        static const size_t BlockSize = (size_t(1) << 16) * 82 / (BasicBoard<BoxSize>::CellCount + 1);
+    };
+
+    //Write the result of one puzzle, returns how many characters were written
+    //solution is CellCount characters when the puzzle was solved and ignored otherwise
+    //As text, solved puzzles are written as one character per cell and anything else gets a short status word
+    //As binary, the record holds the puzzle and its solution, and lines too short to be a puzzle are stored as an empty grid
+    template <int BoxSize>
+    int WriteResult(const char* line, size_t length, SolveStatus status, const char* solution, int solutions, bool counting,
+        BatchFormat format, char* result)
+    {
+        const auto cellCount = BasicBoard<BoxSize>::CellCount;
+        static const char Invalid[] = "invalid\n";
+        static const char Unsolvable[] = "unsolvable\n";
+        static const char Exceeded[] = "exceeded\n";
+        static const char Cancelled[] = "cancelled\n";
+
+        if (format == BatchFormat::Binary)
+        {
+            char puzzle[cellCount];
+            if (length < (size_t)cellCount)
+            {
+                std::fill(puzzle, puzzle + cellCount, '.');
+                line = puzzle;
+            }
+            //A puzzle that was stopped has no answer, so it is stored as unsolved
+            const auto solved = status == SolveStatus::Solved;
+            const auto stopped = status == SolveStatus::BudgetExceeded || status == SolveStatus::Cancelled;
+            const auto recordStatus = solved ? RecordStatus::Solved
+                : stopped ? RecordStatus::Puzzle
+                : status == SolveStatus::Unsolvable ? RecordStatus::Unsolvable : RecordStatus::Invalid;
+            PackRecord<BoxSize>(line, solved ? solution : nullptr, recordStatus, result);
+            return (int)BinaryFormat<BoxSize>::RecordSize;
+        }
+
+        switch (status)
+        {
+        case SolveStatus::Solved:
+        {
+            const auto prefix = counting ? snprintf(result, 12, "%d ", solutions) : 0;
+            std::copy(solution, solution + cellCount, result + prefix);
+            result[prefix + cellCount] = '\n';
+            return prefix + cellCount + 1;
+        }
+        case SolveStatus::Unsolvable:
+            std::copy(Unsolvable, Unsolvable + sizeof(Unsolvable) - 1, result);
+            return sizeof(Unsolvable) - 1;
+        case SolveStatus::BudgetExceeded:
+            std::copy(Exceeded, Exceeded + sizeof(Exceeded) - 1, result);
+            return sizeof(Exceeded) - 1;
+        case SolveStatus::Cancelled:
+            std::copy(Cancelled, Cancelled + sizeof(Cancelled) - 1, result);
+            return sizeof(Cancelled) - 1;
+        case SolveStatus::InvalidInput:
+        default:
+            std::copy(Invalid, Invalid + sizeof(Invalid) - 1, result);
+            return sizeof(Invalid) - 1;
+        }
+    }
+
+    void CountResult(SolveStatus status, int solutions, BatchSummary& summary)
+    {
+        switch (status)
+        {
+        case SolveStatus::Solved:
+            summary.Solved += 1;
+            if (solutions > 1) { summary.Multiple += 1; }
+            break;
+        case SolveStatus::Unsolvable:
+            summary.Unsolvable += 1;
+            break;
+        case SolveStatus::BudgetExceeded:
+        case SolveStatus::Cancelled:
+            summary.Stopped += 1;
+            break;
+        case SolveStatus::InvalidInput:
+        default:
+            summary.Invalid += 1;
+            break;
+        }
+    }
+
+    //A cache in the options answers a puzzle that is a copy of one solved before, keyed on the line it was read from
+    //so lanes that placed different singles of the same puzzle still meet there
+    template <int BoxSize>
+    bool LookupCached(const char* line, BasicSolveOptions<BoxSize> const& options, BasicCacheQuery<BoxSize>& query, SolveStatus& status,
+        char* solution, int& solutions)
+    {
+        const auto limit = options.SolutionLimit > 1 ? options.SolutionLimit : 1;
+        return options.Cache != nullptr && options.Cache->Lookup(line, limit, query, status, solution, solutions);
+    }
+
+    template <int BoxSize>
+    void StoreCached(BasicSolveOptions<BoxSize> const& options, BasicCacheQuery<BoxSize> const& query, SolveStatus status, const char* solution,
+        int solutions)
+    {
+        if (options.Cache != nullptr) { options.Cache->Insert(query, status, solution, solutions); }
+    }
+
+    //Solve a puzzle that has already been read into a board, line is what it was read from
+    template <int BoxSize>
+    int SolveBoard(BasicBoard<BoxSize> const& board, const char* line, size_t length, char* result, BasicMoveStack<BoxSize>& boardStack,
+        BasicSolveOptions<BoxSize> const& options, BatchFormat format, BatchSummary& summary)
+    {
+        using Board = BasicBoard<BoxSize>;
+        char solutionLine[Board::CellCount];
+        auto solutions = 1;
+        auto status = SolveStatus::Solved;
+        const auto counting = options.SolutionLimit > 1;
+        auto query = BasicCacheQuery<BoxSize>();
+        if (!LookupCached(line, options, query, status, solutionLine, solutions))
+        {
+            auto solution = Board();
+            auto guesses = 0;
+            status = counting
+                ? CountSolutions<BoxSize>(board, solution, solutions, guesses, boardStack, options)
+                : Solve<BoxSize>(board, solution, guesses, boardStack, options);
+            summary.Guesses += guesses;
+            if (status == SolveStatus::Solved) { solution.ToLine(solutionLine); }
+            StoreCached(options, query, status, solutionLine, solutions);
+        }
+        CountResult(status, solutions, summary);
+        return WriteResult<BoxSize>(line, length, status, solutionLine, solutions, counting, format, result);
+    }
+
+    //Solve on the engine the options pick when it isn't the masks, the engine starts from puzzle and line is what was read
+    template <int BoxSize>
+    int SolveOnEngine(const char* puzzle, const char* line, size_t length, char* result, BasicSolveOptions<BoxSize> const& options,
+        BatchFormat format, BatchSummary& summary)
+    {
+        char solution[BasicBoard<BoxSize>::CellCount];
+        auto solutions = 0;
+        auto status = SolveStatus::Solved;
+        const auto counting = options.SolutionLimit > 1;
+        auto query = BasicCacheQuery<BoxSize>();
+        if (!LookupCached(line, options, query, status, solution, solutions))
+        {
+            auto guesses = 0;
+            auto budget = StartBudget(options);
+            auto const& engine = GetSolverEngine<BoxSize>(options.Engine);
+            status = engine.Solve(puzzle, solution, counting ? options.SolutionLimit : 1, solutions, guesses, budget.Limited() ? &budget : nullptr);
+            summary.Guesses += guesses;
+            StoreCached(options, query, status, solution, solutions);
+        }
+        CountResult(status, solutions, summary);
+        return WriteResult<BoxSize>(line, length, status, solution, solutions, counting, format, result);
+    }
+
+    //Solve a single line and write its result, returns how many characters were written
+    template <int BoxSize>
+    int SolveLine(const char* line, size_t length, char* result, BasicMoveStack<BoxSize>& boardStack, BasicSolveOptions<BoxSize> const& options,
+        BatchFormat format, BatchSummary& summary)
+    {
+        using Board = BasicBoard<BoxSize>;
+        summary.Puzzles += 1;
+
+        auto board = Board();
+        if (length >= (size_t)Board::CellCount && EngineFor(options.Engine, BoxSize) != Engine::Masks)
+        {
+            return SolveOnEngine<BoxSize>(line, line, length, result, options, format, summary);
+        }
+        if (length < (size_t)Board::CellCount || !Board::FromLine(line, board))
+        {
+            summary.Invalid += 1;
+            return WriteResult<BoxSize>(line, length, SolveStatus::InvalidInput, nullptr, 0, false, format, result);
+        }
+        return SolveBoard(board, line, length, result, boardStack, options, format, summary);
+    }
+
+    //Solves lines a group at a time, one puzzle per lane, so the easy ones never need a board of their own
+    //Lanes are propagated together and only the ones that get stuck go through the scalar search,
+    //starting from the cells the lanes placed. A lane that hits a contradiction starts over from its line,
+    //so clashing givens are still told apart from puzzles without a solution.
+    //A puzzle that singles solve has one solution, so this holds when counting solutions too
+    template <int BoxSize, bool Lockstep = (SUDOKU_LOCKSTEP && BasicBoard<BoxSize>::Size <= 16)>
+    class GroupSolver
+    {
+    public:
+        int Lanes() const
+        {
+            return m_lockstep.Lanes();
+        }
+
+        //Result i goes to results + i * Results::Size and its length to lengths[i]
+        void Solve(LineRef const* lines, size_t count, char* results, unsigned short* lengths, BasicMoveStack<BoxSize>& boardStack,
+            BasicSolveOptions<BoxSize> const& options, BatchFormat format, BatchSummary& summary)
+        {
+            size_t open[MaxLockstepLanes];
+            const auto opened = Propagate(lines, count, results, lengths, open, options, format, summary);
+            for (size_t j = 0; j < opened; ++j)
+            {
+                const auto i = open[j];
+                SolveOpen(i, lines[i], results + i * Results<BoxSize>::Size, lengths[i], boardStack, options, format, summary);
+            }
+        }
+
+        //Propagates the lanes together and answers the lines singles solve, open gets the index of every other line
+        //Returns how many were left open, each to be finished with SolveOpen before the next group
+        size_t Propagate(LineRef const* lines, size_t count, char* results, unsigned short* lengths, size_t* open,
+            BasicSolveOptions<BoxSize> const& options, BatchFormat format, BatchSummary& summary)
+        {
+            using Board = BasicBoard<BoxSize>;
+            m_lockstep.Clear();
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_loaded[i] = lines[i].Length >= (size_t)Board::CellCount && m_lockstep.Load((int)i, lines[i].Data);
+            }
+            m_lockstep.Propagate();
+
+            const auto counting = options.SolutionLimit > 1;
+            char placed[Board::CellCount];
+            size_t opened = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!m_loaded[i] || m_lockstep.Status((int)i) != LaneStatus::Solved)
+                {
+                    open[opened++] = i;
+                    continue;
+                }
+                summary.Puzzles += 1;
+                m_lockstep.ToLine((int)i, placed);
+                CountResult(SolveStatus::Solved, 1, summary);
+                lengths[i] = (unsigned short)WriteResult<BoxSize>(lines[i].Data, lines[i].Length, SolveStatus::Solved, placed, 1, counting, format,
+                    results + i * Results<BoxSize>::Size);
+            }
+            return opened;
+        }
+
+        //Searches line i of the group, from the cells its lane placed unless the lane hit a contradiction
+        void SolveOpen(size_t i, LineRef const& line, char* result, unsigned short& length, BasicMoveStack<BoxSize>& boardStack,
+            BasicSolveOptions<BoxSize> const& options, BatchFormat format, BatchSummary& summary)
+        {
+            using Board = BasicBoard<BoxSize>;
+            if (!m_loaded[i] || m_lockstep.Status((int)i) == LaneStatus::Contradiction)
+            {
+                length = (unsigned short)SolveLine(line.Data, line.Length, result, boardStack, options, format, summary);
+                return;
+            }
+
+            summary.Puzzles += 1;
+            char placed[Board::CellCount];
+            m_lockstep.ToLine((int)i, placed);
+            if (EngineFor(options.Engine, BoxSize) != Engine::Masks)
+            {
+                length = (unsigned short)SolveOnEngine<BoxSize>(placed, line.Data, line.Length, result, options, format, summary);
+            }
+            else
+            {
+                Board::FromLine(placed, m_board);
+                length = (unsigned short)SolveBoard(m_board, line.Data, line.Length, result, boardStack, options, format, summary);
+            }
+        }
+
+    private:
+        BasicLockstepSolver<BoxSize> m_lockstep;
+        BasicBoard<BoxSize> m_board;
+        bool m_loaded[MaxLockstepLanes];
+    };
+
+    //Grids too big for the lanes go one line at a time
+    template <int BoxSize>
+    class GroupSolver<BoxSize, false>
+    {
+    public:
+        int Lanes() const
+        {
+            return 1;
+        }
+
+        void Solve(LineRef const* lines, size_t count, char* results, unsigned short* lengths, BasicMoveStack<BoxSize>& boardStack,
+            BasicSolveOptions<BoxSize> const& options, BatchFormat format, BatchSummary& summary)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto result = results + i * Results<BoxSize>::Size;
+                lengths[i] = (unsigned short)SolveLine(lines[i].Data, lines[i].Length, result, boardStack, options, format, summary);
+            }
+        }
+
+        //Nothing is answered before the search here, every line is left open
+        size_t Propagate(LineRef const*, size_t count, char*, unsigned short*, size_t* open, BasicSolveOptions<BoxSize> const&, BatchFormat,
+            BatchSummary&)
+        {
+            for (size_t i = 0; i < count; ++i) { open[i] = i; }
+            return count;
+        }
+
+        void SolveOpen(size_t, LineRef const& line, char* result, unsigned short& length, BasicMoveStack<BoxSize>& boardStack,
+            BasicSolveOptions<BoxSize> const& options, BatchFormat format, BatchSummary& summary)
+        {
+            length = (unsigned short)SolveLine(line.Data, line.Length, result, boardStack, options, format, summary);
+        }
+    };
+
+    //Strip the line ending, returns false for blank lines so trailing newlines don't produce bogus results
+    bool ReadPuzzleLine(std::istream& in, std::string& line)
+    {
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+            if (!line.empty()) { return true; }
+        }
+        return false;
+    }
+
+    void AddSummary(BatchSummary& total, BatchSummary const& part)
+    {
+        total.Puzzles += part.Puzzles;
+        total.Solved += part.Solved;
+        total.Unsolvable += part.Unsolvable;
+        total.Invalid += part.Invalid;
+        total.Stopped += part.Stopped;
+        total.Multiple += part.Multiple;
+        total.Guesses += part.Guesses;
+    }
+
+    //Everything a worker touches while solving, padded so neighbouring workers don't share cache lines
+    template <int BoxSize>
+    struct WorkerState
+    {
+        BasicMoveStack<BoxSize> BoardStack;
+        GroupSolver<BoxSize> Group;
+        BatchSummary Summary;
+        char Padding[64];
+    };
+
+    //Solve one puzzle per line and write one result per line, in the same order
+    //Lines are read a group at a time, one for each lane of the lockstep solver
+    template <int BoxSize>
+    BatchSummary SolveStream(std::istream& in, std::ostream& out, BasicSolveOptions<BoxSize> const& options, BatchFormat format)
+    {
+        const auto resultSize = Results<BoxSize>::Size;
+        WorkerState<BoxSize> state;
+        const auto lanes = (size_t)state.Group.Lanes();
+        std::vector<std::string> lines(lanes);
+        std::vector<LineRef> group(lanes);
+        std::vector<char> results(lanes * resultSize);
+        std::vector<unsigned short> lengths(lanes);
+
+        for (;;)
+        {
+            size_t count = 0;
+            while (count < lanes && ReadPuzzleLine(in, lines[count]))
+            {
+                group[count] = LineRef{ lines[count].data(), lines[count].size() };
+                ++count;
+            }
+            if (count == 0) { break; }
+
+            state.Group.Solve(group.data(), count, results.data(), lengths.data(), state.BoardStack, options, format, state.Summary);
+            for (size_t i = 0; i < count; ++i)
+            {
+                out.write(&results[i * resultSize], lengths[i]);
+            }
+            if (count < lanes) { break; }
+        }
+
+        return state.Summary;
+    }
+
+    //Same output as SolveStream, but each block of lines is solved across the pool a group at a time
+    //Results go into a slot per line so they can be written back in input order
+    template <int BoxSize>
+    BatchSummary SolveStream(std::istream& in, std::ostream& out, ThreadPool& pool, BasicSolveOptions<BoxSize> const& options, BatchFormat format)
+    {
+        const auto resultSize = Results<BoxSize>::Size;
+        const auto blockSize = Results<BoxSize>::BlockSize;
+        std::vector<WorkerState<BoxSize>> workers(pool.Size());
+        const auto lanes = (size_t)workers[0].Group.Lanes();
+        std::vector<std::string> lines(blockSize);
+        std::vector<char> results(blockSize * resultSize);
+        std::vector<unsigned short> lengths(blockSize);
+        size_t count = 0;
+
+        auto solveGroup = [&](int worker, size_t index) {
+            auto& state = workers[worker];
+            const auto first = index * lanes;
+            const auto size = std::min(lanes, count - first);
+            LineRef group[MaxLockstepLanes];
+            for (size_t i = 0; i < size; ++i)
+            {
+                group[i] = LineRef{ lines[first + i].data(), lines[first + i].size() };
+            }
+            state.Group.Solve(group, size, &results[first * resultSize], &lengths[first], state.BoardStack, options, format, state.Summary);
+        };
+
+        for (;;)
+        {
+            count = 0;
+            while (count < blockSize && ReadPuzzleLine(in, lines[count])) { ++count; }
+            if (count == 0) { break; }
+
+            pool.ParallelFor((count + lanes - 1) / lanes, solveGroup);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                out.write(&results[i * resultSize], lengths[i]);
+            }
+            if (count < blockSize) { break; }
+        }
+
+        BatchSummary summary;
+        for (auto const& state : workers)
+        {
+            AddSummary(summary, state.Summary);
+        }
+        return summary;
+    }
+
+    //Walks the puzzles of a buffer, which are either text lines or the records of a binary file
+    template <int BoxSize>
+    class PuzzleReader
+    {
+    public:
+        using Format = BinaryFormat<BoxSize>;
+
+        PuzzleReader(const char* data, size_t size)
+            : m_position(data)
+            , m_end(data + size)
+            , m_binary(false)
+        {
+            auto header = BinaryHeader();
+            if (ReadBinaryHeader(data, size, header) && header.BoxSize == BoxSize && header.RecordSize == Format::RecordSize)
+            {
+                m_binary = true;
+                m_position = data + header.DataOffset;
+                m_end = m_position + header.RecordCount * Format::RecordSize;
+            }
+        }
+
+        //A record is handed out whole, Text turns it into a line
+        bool Next(LineRef& puzzle)
+        {
+            if (!m_binary) { return NextLine(m_position, m_end, puzzle); }
+            if (m_position == m_end) { return false; }
+            puzzle.Data = m_position;
+            puzzle.Length = Format::RecordSize;
+            m_position += Format::RecordSize;
+            return true;
+        }
+
+        //The puzzle as a line, unpacked into buffer when it came from a record
+        //An Invalid record comes back as an empty line, so it is answered the same as the text it was made from
+        LineRef Text(LineRef const& puzzle, char* buffer) const
+        {
+            if (!m_binary) { return puzzle; }
+            const auto status = UnpackRecord<BoxSize>(puzzle.Data, false, buffer, nullptr);
+            return LineRef{ buffer, status == RecordStatus::Invalid ? 0 : (size_t)Format::CellCount };
+        }
+
+    private:
+        const char* m_position;
+        const char* m_end;
+        bool m_binary;
+    };
+
+    //Results are formatted a group at a time and written through the writer's buffer, lines are never copied on the way in
+    template <int BoxSize>
+    BatchSummary SolveBuffer(const char* data, size_t size, BufferedWriter& out, BasicSolveOptions<BoxSize> const& options, BatchFormat format)
+    {
+        const auto cellCount = (size_t)BasicBoard<BoxSize>::CellCount;
+        const auto resultSize = Results<BoxSize>::Size;
+        WorkerState<BoxSize> state;
+        const auto lanes = (size_t)state.Group.Lanes();
+        auto reader = PuzzleReader<BoxSize>(data, size);
+        std::vector<char> records(lanes * cellCount);
+        std::vector<LineRef> group(lanes);
+        std::vector<char> results(lanes * resultSize);
+        std::vector<unsigned short> lengths(lanes);
+
+        for (;;)
+        {
+            size_t count = 0;
+            LineRef puzzle;
+            while (count < lanes && reader.Next(puzzle))
+            {
+                group[count] = reader.Text(puzzle, &records[count * cellCount]);
+                ++count;
+            }
+            if (count == 0) { break; }
+
+            state.Group.Solve(group.data(), count, results.data(), lengths.data(), state.BoardStack, options, format, state.Summary);
+            for (size_t i = 0; i < count; ++i)
+            {
+                out.Write(&results[i * resultSize], lengths[i]);
+            }
+            if (count < lanes) { break; }
+        }
+
+        return state.Summary;
+    }
+
+    //Same as the stream version, but a block only holds pointers into the buffer rather than copies of its lines
+    template <int BoxSize>
+    BatchSummary SolveBuffer(const char* data, size_t size, BufferedWriter& out, ThreadPool& pool, BasicSolveOptions<BoxSize> const& options,
+        BatchFormat format)
+    {
+        const auto cellCount = (size_t)BasicBoard<BoxSize>::CellCount;
+        const auto resultSize = Results<BoxSize>::Size;
+        const auto blockSize = Results<BoxSize>::BlockSize;
+        std::vector<WorkerState<BoxSize>> workers(pool.Size());
+        const auto lanes = (size_t)workers[0].Group.Lanes();
+        std::vector<LineRef> puzzles(blockSize);
+        std::vector<char> results(blockSize * resultSize);
+        std::vector<unsigned short> lengths(blockSize);
+        auto reader = PuzzleReader<BoxSize>(data, size);
+        size_t count = 0;
+
+        auto solveGroup = [&](int worker, size_t index) {
+            auto& state = workers[worker];
+            const auto first = index * lanes;
+            const auto size = std::min(lanes, count - first);
+            char records[MaxLockstepLanes * cellCount];
+            LineRef group[MaxLockstepLanes];
+            for (size_t i = 0; i < size; ++i)
+            {
+                group[i] = reader.Text(puzzles[first + i], &records[i * cellCount]);
+            }
+            state.Group.Solve(group, size, &results[first * resultSize], &lengths[first], state.BoardStack, options, format, state.Summary);
+        };
+
+        for (;;)
+        {
+            count = 0;
+            while (count < blockSize && reader.Next(puzzles[count])) { ++count; }
+            if (count == 0) { break; }
+
+            pool.ParallelFor((count + lanes - 1) / lanes, solveGroup);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                out.Write(&results[i * resultSize], lengths[i]);
+            }
+            if (count < blockSize) { break; }
+        }
+
+        BatchSummary summary;
+        for (auto const& state : workers)
+        {
+            AddSummary(summary, state.Summary);
+        }
+        return summary;
+    }
+
+    template <int BoxSize>
+    struct BasicLineSolver<BoxSize>::State : WorkerState<BoxSize>
+    {
+    };
+
+    template <int BoxSize>
+    BasicLineSolver<BoxSize>::BasicLineSolver()
+        : m_state(new State())
+    {
+    }
+
+    template <int BoxSize>
+    BasicLineSolver<BoxSize>::~BasicLineSolver() = default;
+
+    template <int BoxSize>
+    int BasicLineSolver<BoxSize>::GroupSize() const
+    {
+        return m_state->Group.Lanes();
+    }
+
+    template <int BoxSize>
+    void BasicLineSolver<BoxSize>::Solve(LineRef const* lines, size_t count, char* results, unsigned short* lengths,
+        BasicSolveOptions<BoxSize> const& options)
+    {
+        auto& state = *m_state;
+        state.Group.Solve(lines, count, results, lengths, state.BoardStack, options, BatchFormat::Text, state.Summary);
+    }
+
+    template <int BoxSize>
+    size_t BasicLineSolver<BoxSize>::Propagate(LineRef const* lines, size_t count, char* results, unsigned short* lengths, size_t* open,
+        BasicSolveOptions<BoxSize> const& options)
+    {
+        auto& state = *m_state;
+        return state.Group.Propagate(lines, count, results, lengths, open, options, BatchFormat::Text, state.Summary);
+    }
+
+    template <int BoxSize>
+    void BasicLineSolver<BoxSize>::SolveOpen(size_t i, LineRef const* lines, char* results, unsigned short* lengths,
+        BasicSolveOptions<BoxSize> const& options)
+    {
+        auto& state = *m_state;
+        state.Group.SolveOpen(i, lines[i], results + i * ResultSize, lengths[i], state.BoardStack, options, BatchFormat::Text, state.Summary);
+    }
+
+    template <int BoxSize>
+    BatchSummary const& BasicLineSolver<BoxSize>::Summary() const
+    {
+        return m_state->Summary;
+    }
+
+    template class BasicLineSolver<3>;
+    template class BasicLineSolver<4>;
+    template class BasicLineSolver<5>;
+    template BatchSummary SolveStream<3>(std::istream&, std::ostream&, BasicSolveOptions<3> const&, BatchFormat);
+    template BatchSummary SolveStream<4>(std::istream&, std::ostream&, BasicSolveOptions<4> const&, BatchFormat);
+    template BatchSummary SolveStream<5>(std::istream&, std::ostream&, BasicSolveOptions<5> const&, BatchFormat);
+    template BatchSummary SolveStream<3>(std::istream&, std::ostream&, ThreadPool&, BasicSolveOptions<3> const&, BatchFormat);
+    template BatchSummary SolveStream<4>(std::istream&, std::ostream&, ThreadPool&, BasicSolveOptions<4> const&, BatchFormat);
+    template BatchSummary SolveStream<5>(std::istream&, std::ostream&, ThreadPool&, BasicSolveOptions<5> const&, BatchFormat);
+    template BatchSummary SolveBuffer<3>(const char*, size_t, BufferedWriter&, BasicSolveOptions<3> const&, BatchFormat);
+    template BatchSummary SolveBuffer<4>(const char*, size_t, BufferedWriter&, BasicSolveOptions<4> const&, BatchFormat);
+    template BatchSummary SolveBuffer<5>(const char*, size_t, BufferedWriter&, BasicSolveOptions<5> const&, BatchFormat);
+    template BatchSummary SolveBuffer<3>(const char*, size_t, BufferedWriter&, ThreadPool&, BasicSolveOptions<3> const&, BatchFormat);
+    template BatchSummary SolveBuffer<4>(const char*, size_t, BufferedWriter&, ThreadPool&, BasicSolveOptions<4> const&, BatchFormat);
+    template BatchSummary SolveBuffer<5>(const char*, size_t, BufferedWriter&, ThreadPool&, BasicSolveOptions<5> const&, BatchFormat);
+}
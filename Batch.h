@@ -0,0 +1,86 @@
+#pragma once
+#include <istream>
+#include <memory>
+#include <ostream>
+
+#include "Board.h"
+
+namespace Solver
+{
+	struct BatchSummary
+	{
+		long long Puzzles = 0;
+		long long Solved = 0;
+		long long Unsolvable = 0;
+		long long Invalid = 0;
+		//Puzzles that ran out of budget or were cancelled before an answer
+		long long Stopped = 0;
+		//Solved puzzles with more than one solution, only counted when options.SolutionLimit is above 1
+		long long Multiple = 0;
+		long long Guesses = 0;
+	};
+
+	class ThreadPool;
+	class BufferedWriter;
+	struct LineRef;
+
+	//What results are written as, Binary writes the records of PuzzleFile.h without the header,
+	//which the caller writes first so it can fill in the count once the solve is done
+	enum class BatchFormat
+	{
+		Text,
+		Binary
+	};
+
+	//Solve one puzzle per line, BoxSize picks the size of the grids, 3 for 9x9
+	//With options.SolutionLimit above 1 each solution line starts with the number of solutions found, up to the limit
+	template <int BoxSize = 3>
+	BatchSummary SolveStream(std::istream& in, std::ostream& out, BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>(),
+		BatchFormat format = BatchFormat::Text);
+	template <int BoxSize = 3>
+	BatchSummary SolveStream(std::istream& in, std::ostream& out, ThreadPool& pool, BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>(),
+		BatchFormat format = BatchFormat::Text);
+
+	//Same output again, reading lines in place from a buffer such as a MappedFile and writing through a BufferedWriter
+	//This is the fast path for large files, nothing is copied per line on the way in
+	//A buffer that starts with a binary header of the same box size is read as records instead of lines
+	template <int BoxSize = 3>
+	BatchSummary SolveBuffer(const char* data, size_t size, BufferedWriter& out, BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>(),
+		BatchFormat format = BatchFormat::Text);
+	template <int BoxSize = 3>
+	BatchSummary SolveBuffer(const char* data, size_t size, BufferedWriter& out, ThreadPool& pool,
+		BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>(), BatchFormat format = BatchFormat::Text);
+
+	//Solves lines a group at a time for callers that bring their own lines rather than a stream or a buffer, such as the server
+	//Results are the text lines batch mode writes, each ending in a newline
+	//Holds the board stack and lanes of one worker, so each thread needs its own
+	template <int BoxSize = 3>
+	class BasicLineSolver
+	{
+	public:
+		//Room for every cell or a status word, plus the newline and a solution count
+		static const int ResultSize = BasicBoard<BoxSize>::CellCount + 1 + 12;
+
+		BasicLineSolver();
+		~BasicLineSolver();
+
+		//Lines worth handing over at once, one per lockstep lane
+		int GroupSize() const;
+		//Solves up to GroupSize lines, result i goes to results + i * ResultSize and its length to lengths[i]
+		void Solve(LineRef const* lines, size_t count, char* results, unsigned short* lengths, BasicSolveOptions<BoxSize> const& options);
+		//The same in two steps, so the lines propagation answers can go out before any search starts
+		//Propagate writes the results of the lines that need no search and puts the index of every other one in open,
+		//returning how many that is. Each of those is then answered with SolveOpen, with options of its own, before the next group
+		size_t Propagate(LineRef const* lines, size_t count, char* results, unsigned short* lengths, size_t* open,
+			BasicSolveOptions<BoxSize> const& options);
+		void SolveOpen(size_t i, LineRef const* lines, char* results, unsigned short* lengths, BasicSolveOptions<BoxSize> const& options);
+		//Everything solved so far
+		BatchSummary const& Summary() const;
+
+	private:
+		struct State;
+		std::unique_ptr<State> m_state;
+	};
+
+	using LineSolver = BasicLineSolver<3>;
+}
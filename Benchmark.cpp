@@ -0,0 +1,681 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Board.h"
+#include "LockstepSolver.h"
+#include "ParallelSolver.h"
+#include "SolutionCache.h"
+#include "ThreadPool.h"
+
+//Every heap allocation in the process goes through here so the benchmark can count them
+std::atomic<long long> Allocations(0);
+
+void* operator new(size_t size)
+{
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto memory = malloc(size ? size : 1)) { return memory; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+//Latencies in nanoseconds, sorted in place
+struct Latencies
+{
+    std::vector<double> Samples;
+
+    double Mean() const
+    {
+        auto total = 0.0;
+        for (auto sample : Samples) { total += sample; }
+        return Samples.empty() ? 0.0 : total / Samples.size();
+    }
+
+    //Nearest rank, so p99 of fewer than 100 samples is the max
+    double Percentile(double p)
+    {
+        std::sort(Samples.begin(), Samples.end());
+        const auto index = std::min(Samples.size() - 1, (size_t)(p * Samples.size()));
+        return Samples[index];
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+double Nanoseconds(Clock::time_point begin, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::nano>(end - begin).count();
+}
+
+std::vector<Solver::Board> ReadCorpus(const char* path)
+{
+    std::vector<Solver::Board> boards;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto board = Solver::Board();
+        if (Solver::Board::FromLine(line, board)) { boards.push_back(board); }
+    }
+    return boards;
+}
+
+void PrintLatencies(const char* name, Latencies& latencies, long long guesses)
+{
+    printf("%-16s mean %12.0fns  p50 %12.0fns  p99 %12.0fns  max %12.0fns  guesses %lld\n",
+        name, latencies.Mean(), latencies.Percentile(0.5), latencies.Percentile(0.99), latencies.Percentile(1.0), guesses);
+}
+
+//Per puzzle latency of the hardest puzzles, solved one at a time and then split across threads
+int BenchParallel(std::vector<Solver::Board> const& boards, int threads, int repeat, Solver::SolveOptions const& options)
+{
+    Solver::ThreadPool pool(threads);
+    Solver::MoveStack boardStack;
+    Latencies sequential;
+    Latencies parallel;
+    long long sequentialGuesses = 0;
+    long long parallelGuesses = 0;
+    long long sequentialAllocations = 0;
+    long long copies = 0;
+
+    sequential.Samples.reserve(boards.size() * repeat);
+    parallel.Samples.reserve(boards.size() * repeat);
+    for (auto run = 0; run < repeat; ++run)
+    {
+        for (auto const& board : boards)
+        {
+            auto solution = Solver::Board();
+            auto guesses = 0;
+
+            const auto allocations = Allocations.load();
+            auto begin = Clock::now();
+            Solver::Solve(board, solution, guesses, boardStack, options);
+            auto end = Clock::now();
+            sequentialAllocations += Allocations.load() - allocations;
+            copies += boardStack.Copies();
+            sequential.Samples.push_back(Nanoseconds(begin, end));
+            sequentialGuesses += guesses;
+
+            begin = Clock::now();
+            Solver::SolveParallel(board, solution, guesses, pool, options);
+            end = Clock::now();
+            parallel.Samples.push_back(Nanoseconds(begin, end));
+            parallelGuesses += guesses;
+        }
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "parallel x%d", pool.Size());
+    printf("%zu puzzles, %d runs\n", boards.size(), repeat);
+    PrintLatencies("sequential", sequential, sequentialGuesses / repeat);
+    PrintLatencies(name, parallel, parallelGuesses / repeat);
+
+    //The sequential solves reuse one stack, so anything above zero here is an allocation on the solve path
+    const auto solves = (double)boards.size() * repeat;
+    printf("sequential       allocations/solve %.2f  boards copied/solve %.1f  bytes copied/solve %.0f\n",
+        sequentialAllocations / solves, copies / solves, copies * sizeof(Solver::Board) / solves);
+    return 0;
+}
+
+//Sequential latency and guesses of every puzzle solved with the given options
+void BenchSequential(const char* name, std::vector<Solver::Board> const& boards, int repeat, Solver::SolveOptions const& options)
+{
+    Solver::MoveStack boardStack;
+    Latencies latencies;
+    latencies.Samples.reserve(boards.size() * repeat);
+    long long guesses = 0;
+
+    for (auto run = 0; run < repeat; ++run)
+    {
+        for (auto const& board : boards)
+        {
+            auto solution = Solver::Board();
+            auto boardGuesses = 0;
+            auto solutions = 0;
+            const auto begin = Clock::now();
+            if (options.SolutionLimit > 1) { Solver::CountSolutions(board, solution, solutions, boardGuesses, boardStack, options); }
+            else { Solver::Solve(board, solution, boardGuesses, boardStack, options); }
+            const auto end = Clock::now();
+            latencies.Samples.push_back(Nanoseconds(begin, end));
+            guesses += boardGuesses;
+        }
+    }
+
+    PrintLatencies(name, latencies, guesses / repeat);
+}
+
+//Sequential latency and guesses on every corpus with each engine, the mean is the inverse of single thread throughput
+//Each engine also counts solutions up to two, the uniqueness check that generating and validating puzzles needs
+void BenchEngines(std::vector<const char*> const& paths, std::vector<std::vector<Solver::Board>> const& corpora, int repeat,
+    Solver::SolveOptions options)
+{
+    static const Solver::Engine Engines[] = { Solver::Engine::Masks, Solver::Engine::Bitboard, Solver::Engine::DancingLinks };
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        printf("\n%s\n", paths[i]);
+        for (auto limit = 1; limit <= 2; ++limit)
+        {
+            options.SolutionLimit = limit;
+            for (auto engine : Engines)
+            {
+                options.Engine = engine;
+                char name[32];
+                snprintf(name, sizeof(name), "%s %s", limit > 1 ? "count" : "solve", Solver::GetEngineName(engine));
+                BenchSequential(name, corpora[i], repeat, options);
+            }
+        }
+    }
+}
+
+//Sequential latency and guesses under every branching strategy, the guess count is what drives the worst case
+void BenchBranching(std::vector<Solver::Board> const& boards, int repeat, Solver::SolveOptions options)
+{
+    static const struct { const char* Name; Solver::Branching Branching; } Strategies[] = {
+        { "first", Solver::Branching::FirstEmpty },
+        { "mrv", Solver::Branching::MinimumRemaining },
+        { "degree", Solver::Branching::MinimumRemainingDegree },
+        { "lcv", Solver::Branching::LeastConstraining },
+    };
+
+    for (auto const& strategy : Strategies)
+    {
+        options.Strategy = &Solver::GetBranchStrategy(strategy.Branching);
+        char name[32];
+        snprintf(name, sizeof(name), "branch %s", strategy.Name);
+        BenchSequential(name, boards, repeat, options);
+    }
+}
+
+//Each deduction on its own and then all of them, compared to none by total time as well as guesses
+//A technique only pays off when it saves more time in guesses than it spends looking
+void BenchDeductions(std::vector<Solver::Board> const& boards, int repeat, Solver::SolveOptions options)
+{
+    static const Solver::Deduction Deductions[] = {
+        Solver::PointingPairs, Solver::BoxLineReduction, Solver::NakedPairs, Solver::HiddenPairs,
+        Solver::XWing, Solver::NakedTriples, Solver::HiddenTriples, Solver::Swordfish
+    };
+
+    options.Deductions = Solver::NoDeductions;
+    BenchSequential("deduce none", boards, repeat, options);
+    for (auto deduction : Deductions)
+    {
+        options.Deductions = deduction;
+        char name[32];
+        snprintf(name, sizeof(name), "deduce %s", Solver::GetDeductionName(deduction));
+        BenchSequential(name, boards, repeat, options);
+    }
+    options.Deductions = Solver::AllDeductions;
+    BenchSequential("deduce all", boards, repeat, options);
+}
+
+//Single thread throughput solving one puzzle at a time against propagating a register's worth in lockstep first,
+//with every kernel this CPU can run. Puzzles the lanes can't finish are searched from where the lanes left them,
+//so both sides solve every puzzle. Propagation alone is timed as well, the scalar side being SetInitialData and SolveKnown
+void BenchLockstep(std::vector<Solver::Board> const& boards, int repeat, Solver::SolveOptions const& options)
+{
+    static const Solver::LockstepKernel Kernels[] = {
+        Solver::LockstepKernel::Plain, Solver::LockstepKernel::Sse2, Solver::LockstepKernel::Avx2, Solver::LockstepKernel::Avx512
+    };
+    std::vector<std::string> lines;
+    for (auto const& board : boards)
+    {
+        std::string line(Solver::Board::CellCount, '.');
+        board.ToLine(&line[0]);
+        lines.push_back(line);
+    }
+    const auto total = (double)boards.size() * repeat;
+
+    Solver::MoveStack boardStack;
+    auto solution = Solver::Board();
+    auto guesses = 0;
+    auto begin = Clock::now();
+    for (auto run = 0; run < repeat; ++run)
+    {
+        for (auto const& board : boards)
+        {
+            Solver::Solve(board, solution, guesses, boardStack, options);
+        }
+    }
+    const auto scalar = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    begin = Clock::now();
+    for (auto run = 0; run < repeat; ++run)
+    {
+        for (auto const& board : boards)
+        {
+            auto copy = board;
+            copy.SetInitialData();
+            copy.SolveKnown();
+        }
+    }
+    const auto scalarPropagation = Nanoseconds(begin, Clock::now()) / total;
+    printf("one at a time       %12.0f puzzles/s                                 propagation %6.0fns/puzzle\n",
+        total / scalar, scalarPropagation);
+
+    for (auto kernel : Kernels)
+    {
+        if (!Solver::LockstepKernelSupported(kernel)) { continue; }
+
+        Solver::LockstepSolver lockstep(kernel);
+        const auto lanes = (size_t)lockstep.Lanes();
+        char placed[Solver::Board::CellCount];
+        long long solvedInLanes = 0;
+        auto propagation = 0.0;
+        begin = Clock::now();
+        for (auto run = 0; run < repeat; ++run)
+        {
+            for (size_t first = 0; first < lines.size(); first += lanes)
+            {
+                const auto count = std::min(lanes, lines.size() - first);
+                const auto propagationBegin = Clock::now();
+                lockstep.Clear();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    lockstep.Load((int)i, lines[first + i].data());
+                }
+                lockstep.Propagate();
+                propagation += Nanoseconds(propagationBegin, Clock::now());
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const auto status = lockstep.Status((int)i);
+                    if (status == Solver::LaneStatus::Solved)
+                    {
+                        solvedInLanes += 1;
+                        continue;
+                    }
+                    auto board = boards[first + i];
+                    if (status == Solver::LaneStatus::Open)
+                    {
+                        lockstep.ToLine((int)i, placed);
+                        Solver::Board::FromLine(placed, board);
+                    }
+                    Solver::Solve(board, solution, guesses, boardStack, options);
+                }
+            }
+        }
+        const auto vector = std::chrono::duration<double>(Clock::now() - begin).count();
+
+        char name[32];
+        snprintf(name, sizeof(name), "lockstep %s x%zu", Solver::GetLockstepKernelName(kernel), lanes);
+        printf("%-19s %12.0f puzzles/s  %5.1f%% solved in lanes  %5.2fx  propagation %6.0fns/puzzle  %5.2fx\n",
+            name, total / vector, 100.0 * solvedInLanes / total, scalar / vector, propagation / total, scalarPropagation * total / propagation);
+    }
+}
+
+//A random symmetry of the grid, bands and stacks shuffled, rows and columns shuffled within them and values relabeled
+Solver::GridTransform RandomTransform(std::mt19937& random)
+{
+    const auto boxSize = 3;
+    auto transform = Solver::GridTransform();
+    transform.Transposed = (random() & 1) != 0;
+    unsigned char* lines[] = { transform.Rows, transform.Columns };
+    for (auto line : lines)
+    {
+        int bands[boxSize] = { 0, 1, 2 };
+        std::shuffle(bands, bands + boxSize, random);
+        for (auto b = 0; b < boxSize; ++b)
+        {
+            int within[boxSize] = { 0, 1, 2 };
+            std::shuffle(within, within + boxSize, random);
+            for (auto k = 0; k < boxSize; ++k) { line[b * boxSize + k] = (unsigned char)(bands[b] * boxSize + within[k]); }
+        }
+    }
+    for (auto v = 0; v <= Solver::Board::Size; ++v) { transform.Labels[v] = (unsigned char)v; }
+    std::shuffle(transform.Labels + 1, transform.Labels + Solver::Board::Size + 1, random);
+    return transform;
+}
+
+//Every puzzle followed by copies of the whole corpus taken through random symmetries, solved one at a time with and
+//without a cache in front, one with room for twice the corpus so uneven shards never evict anything
+//The copies are what the cache is for, and every miss pays for canonicalizing on top of the solve
+void BenchCache(std::vector<const char*> const& paths, std::vector<std::vector<Solver::Board>> const& corpora, int repeat,
+    Solver::SolveOptions const& options)
+{
+    const auto copies = 3;
+    auto random = std::mt19937(12345);
+    printf("\nsolution cache, each corpus followed by %d copies through random symmetries\n", copies);
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        auto const& boards = corpora[i];
+        std::vector<std::string> lines;
+        for (auto copy = 0; copy <= copies; ++copy)
+        {
+            for (auto const& board : boards)
+            {
+                std::string line(Solver::Board::CellCount, '.');
+                board.ToLine(&line[0]);
+                if (copy > 0)
+                {
+                    const auto original = line;
+                    Solver::ApplyTransform(RandomTransform(random), original.data(), &line[0]);
+                }
+                lines.push_back(line);
+            }
+        }
+        const auto total = (double)lines.size() * repeat;
+
+        Solver::MoveStack boardStack;
+        auto solution = Solver::Board();
+        auto guesses = 0;
+        auto begin = Clock::now();
+        for (auto run = 0; run < repeat; ++run)
+        {
+            for (auto const& line : lines)
+            {
+                auto board = Solver::Board();
+                Solver::Board::FromLine(line, board);
+                Solver::Solve(board, solution, guesses, boardStack, options);
+            }
+        }
+        const auto uncached = std::chrono::duration<double>(Clock::now() - begin).count();
+
+        auto stats = Solver::CacheStats();
+        begin = Clock::now();
+        for (auto run = 0; run < repeat; ++run)
+        {
+            Solver::SolutionCache cache(2 * boards.size());
+            for (auto const& line : lines)
+            {
+                auto query = Solver::BasicCacheQuery<3>();
+                auto status = Solver::SolveStatus::Solved;
+                char solutionLine[Solver::Board::CellCount];
+                auto solutions = 1;
+                if (cache.Lookup(line.data(), 1, query, status, solutionLine, solutions)) { continue; }
+
+                auto board = Solver::Board();
+                Solver::Board::FromLine(line, board);
+                status = Solver::Solve(board, solution, guesses, boardStack, options);
+                if (status == Solver::SolveStatus::Solved) { solution.ToLine(solutionLine); }
+                cache.Insert(query, status, solutionLine, 1);
+            }
+            const auto runStats = cache.Stats();
+            stats.Lookups += runStats.Lookups;
+            stats.Hits += runStats.Hits;
+            stats.LookupNs += runStats.LookupNs;
+        }
+        const auto cached = std::chrono::duration<double>(Clock::now() - begin).count();
+
+        printf("%-24s %10.0f puzzles/s  cached %10.0f puzzles/s  %5.2fx  %5.1f%% hits  lookup %6.0fns\n", paths[i],
+            total / uncached, total / cached, uncached / cached, stats.Lookups > 0 ? 100.0 * stats.Hits / stats.Lookups : 0.0,
+            stats.Lookups > 0 ? (double)stats.LookupNs / stats.Lookups : 0.0);
+    }
+}
+
+//Stats divided by count, so totals over a corpus come out per puzzle
+void PrintStats(const char* name, Solver::SolveStats const& stats, double count)
+{
+    const auto time = (double)(stats.PropagationNs + stats.SearchNs);
+    printf("%-14s guesses %.1f  backtracks %.1f  depth %d  singles %.1f  hidden %.1f  copies %.1f  propagation %.0f%% of %.0fns",
+        name, stats.Guesses / count, stats.Backtracks / count, stats.MaxDepth, stats.Singles / count, stats.HiddenSingles / count,
+        stats.Copies / count, time > 0 ? 100.0 * stats.PropagationNs / time : 0.0, time / count);
+    if (stats.Cycles >= 0)
+    {
+        printf("  cycles %.0f  branch misses %.1f  cache misses %.1f", stats.Cycles / count, stats.BranchMisses / count, stats.CacheMisses / count);
+    }
+    printf("\n");
+}
+
+//What one corpus measured, kept so it can be written out as JSON after everything has run
+struct CorpusResult
+{
+    std::string Name;
+    std::string Path;
+    size_t Puzzles = 0;
+    double PuzzlesPerSecond = 0.0;
+    double Mean = 0.0;
+    double P50 = 0.0;
+    double P99 = 0.0;
+    double Max = 0.0;
+    double MeanGuesses = 0.0;
+    //Totals from one more pass with stats on, and the puzzle that took longest in it
+    Solver::SolveStats Stats;
+    size_t Slowest = 0;
+    Solver::SolveStats SlowestStats;
+};
+
+//Name a corpus by its file name without the directory or extension
+std::string CorpusName(const char* path)
+{
+    std::string name(path);
+    const auto slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) { name.erase(0, slash + 1); }
+    const auto dot = name.find_last_of('.');
+    if (dot != std::string::npos && dot > 0) { name.erase(dot); }
+    return name;
+}
+
+//Latency comes from solving one puzzle at a time on worker 0, throughput from every worker solving the corpus at once
+//Both are measured after warmup untimed passes so the caches and branch predictors have seen the puzzles
+CorpusResult BenchCorpus(const char* path, std::vector<Solver::Board> const& boards, Solver::ThreadPool& pool,
+    int warmup, int repeat, Solver::SolveOptions const& options)
+{
+    std::vector<Solver::MoveStack> boardStacks(pool.Size());
+    const auto total = boards.size() * repeat;
+    auto solveIndex = [&](int worker, size_t index) {
+        auto solution = Solver::Board();
+        auto guesses = 0;
+        Solver::Solve(boards[index % boards.size()], solution, guesses, boardStacks[worker], options);
+    };
+
+    for (auto run = 0; run < warmup; ++run)
+    {
+        pool.ParallelFor(boards.size(), solveIndex);
+    }
+
+    Latencies latencies;
+    latencies.Samples.reserve(total);
+    long long guesses = 0;
+    for (size_t index = 0; index < total; ++index)
+    {
+        auto solution = Solver::Board();
+        auto boardGuesses = 0;
+        const auto begin = Clock::now();
+        Solver::Solve(boards[index % boards.size()], solution, boardGuesses, boardStacks[0], options);
+        const auto end = Clock::now();
+        latencies.Samples.push_back(Nanoseconds(begin, end));
+        guesses += boardGuesses;
+    }
+
+    const auto begin = Clock::now();
+    pool.ParallelFor(total, solveIndex);
+    const auto end = Clock::now();
+
+    CorpusResult result;
+    result.Name = CorpusName(path);
+    result.Path = path;
+    result.Puzzles = boards.size();
+    result.PuzzlesPerSecond = total / std::chrono::duration<double>(end - begin).count();
+    result.Mean = latencies.Mean();
+    result.P50 = latencies.Percentile(0.5);
+    result.P99 = latencies.Percentile(0.99);
+    result.Max = latencies.Percentile(1.0);
+    result.MeanGuesses = (double)guesses / total;
+
+    //Counting slows the solves down, so it gets its own pass after the timed ones
+    Solver::HardwareCounters counters;
+    for (size_t index = 0; index < boards.size(); ++index)
+    {
+        auto solution = Solver::Board();
+        auto boardGuesses = 0;
+        auto stats = Solver::SolveStats();
+        counters.Start();
+        Solver::Solve<3>(boards[index], solution, boardGuesses, boardStacks[0], options, nullptr, &stats);
+        counters.Stop(stats);
+
+        if (index == 0) { result.Stats = stats; }
+        else { Solver::AddStats(result.Stats, stats); }
+        if (index == 0 || stats.PropagationNs + stats.SearchNs > result.SlowestStats.PropagationNs + result.SlowestStats.SearchNs)
+        {
+            result.Slowest = index;
+            result.SlowestStats = stats;
+        }
+    }
+
+    printf("%-12s %6zu puzzles %12.0f puzzles/s  p50 %12.0fns  p99 %12.0fns  max %12.0fns  guesses %.2f\n",
+        result.Name.c_str(), result.Puzzles, result.PuzzlesPerSecond, result.P50, result.P99, result.Max, result.MeanGuesses);
+    if (SUDOKU_STATS)
+    {
+        PrintStats("  per puzzle", result.Stats, (double)boards.size());
+        char name[32];
+        snprintf(name, sizeof(name), "  slowest #%zu", result.Slowest + 1);
+        PrintStats(name, result.SlowestStats, 1.0);
+    }
+    return result;
+}
+
+//Corpus names come from file names, so only quotes and backslashes need escaping
+void WriteJsonString(FILE* file, std::string const& text)
+{
+    fputc('"', file);
+    for (auto c : text)
+    {
+        if (c == '"' || c == '\\') { fputc('\\', file); }
+        fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+//One object per run so results from different versions can be lined up and compared by a script
+bool WriteJson(const char* path, std::vector<CorpusResult> const& results, Solver::Engine engine, int threads, bool pinned,
+    int warmup, int repeat)
+{
+    auto file = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (file == nullptr) { return false; }
+
+    fprintf(file, "{\n  \"engine\": \"%s\",\n  \"threads\": %d,\n  \"pinned\": %s,\n  \"warmup\": %d,\n  \"repeat\": %d,\n  \"corpora\": [",
+        Solver::GetEngineName(engine), threads, pinned ? "true" : "false", warmup, repeat);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        auto const& result = results[i];
+        fprintf(file, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+        WriteJsonString(file, result.Name);
+        fprintf(file, ", \"path\": ");
+        WriteJsonString(file, result.Path);
+        fprintf(file, ", \"puzzles\": %zu, \"puzzles_per_second\": %.1f, "
+            "\"latency_ns\": {\"mean\": %.0f, \"p50\": %.0f, \"p99\": %.0f, \"max\": %.0f}, \"mean_guesses\": %.3f",
+            result.Puzzles, result.PuzzlesPerSecond, result.Mean, result.P50, result.P99, result.Max, result.MeanGuesses);
+        //Stats are totals over one pass of the corpus, hardware counts are -1 where they couldn't be read
+        auto const& stats = result.Stats;
+        if (SUDOKU_STATS)
+        {
+            fprintf(file, ", \"stats\": {\"backtracks\": %lld, \"max_depth\": %d, \"solve_known_iterations\": %lld, "
+                "\"singles\": %lld, \"hidden_singles\": %lld, \"copies\": %lld, \"propagation_ns\": %lld, \"search_ns\": %lld, "
+                "\"cycles\": %lld, \"branch_misses\": %lld, \"cache_misses\": %lld}",
+                stats.Backtracks, stats.MaxDepth, stats.SolveKnownIterations, stats.Singles, stats.HiddenSingles, stats.Copies,
+                stats.PropagationNs, stats.SearchNs, stats.Cycles, stats.BranchMisses, stats.CacheMisses);
+        }
+        fprintf(file, "}");
+    }
+    fprintf(file, "\n  ]\n}\n");
+
+    if (file != stdout) { fclose(file); }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    //Easy puzzles show the cost of the setup and propagation, the others the cost of the search
+    std::vector<const char*> paths = { "corpus/easy.txt", "corpus/17clue.txt", "corpus/hardest.txt" };
+    const char* jsonPath = nullptr;
+    auto threads = 0;
+    auto warmup = 1;
+    auto repeat = 20;
+    auto compare = false;
+    auto options = Solver::SolveOptions();
+    for (auto i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { threads = atoi(argv[++i]); }
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) { warmup = std::max(0, atoi(argv[++i])); }
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) { repeat = std::max(1, atoi(argv[++i])); }
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) { jsonPath = argv[++i]; }
+        else if (strcmp(argv[i], "--compare") == 0) { compare = true; }
+        else if (strcmp(argv[i], "--branch") == 0 && i + 1 < argc)
+        {
+            auto branching = Solver::Branching::MinimumRemaining;
+            if (!Solver::ParseBranching(argv[++i], branching))
+            {
+                fprintf(stderr, "Unknown branching %s, expected first, mrv, degree or lcv\n", argv[i]);
+                return 1;
+            }
+            options.Strategy = &Solver::GetBranchStrategy(branching);
+        }
+        else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc)
+        {
+            if (!Solver::ParseEngine(argv[++i], options.Engine))
+            {
+                fprintf(stderr, "Unknown engine %s, expected masks, bitboard or dlx\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--deduce") == 0 && i + 1 < argc)
+        {
+            if (!Solver::ParseDeductions(argv[++i], options.Deductions))
+            {
+                fprintf(stderr, "Unknown deductions %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else { paths.push_back(argv[i]); }
+    }
+
+    std::vector<std::vector<Solver::Board>> corpora;
+    for (auto path : paths)
+    {
+        corpora.push_back(ReadCorpus(path));
+        if (corpora.back().empty())
+        {
+            fprintf(stderr, "No puzzles read from %s\n", path);
+            return 1;
+        }
+    }
+
+    //Pinned workers keep their caches and don't wander onto a core another worker is timing on
+    Solver::ThreadPool pool(threads);
+    const auto pinned = pool.PinThreads();
+    printf("%d threads%s, %d warm-up and %d timed runs, %s engine\n", pool.Size(), pinned ? " pinned" : "", warmup, repeat,
+        Solver::GetEngineName(options.Engine));
+
+    std::vector<CorpusResult> results;
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        results.push_back(BenchCorpus(paths[i], corpora[i], pool, warmup, repeat, options));
+    }
+    if (jsonPath != nullptr && !WriteJson(jsonPath, results, options.Engine, pool.Size(), pinned, warmup, repeat))
+    {
+        fprintf(stderr, "Unable to write %s\n", jsonPath);
+        return 1;
+    }
+    if (!compare) { return 0; }
+
+    //Lockstep pays off on the puzzles singles alone can solve, so it runs on the first corpus, the easy set by default
+    printf("\n%s\n", paths.front());
+    BenchLockstep(corpora.front(), repeat, options);
+    BenchEngines(paths, corpora, repeat, options);
+    BenchCache(paths, corpora, repeat, options);
+
+    //The detailed comparisons run on the last corpus, the hardest set unless another was given
+    auto const& boards = corpora.back();
+    printf("\n%s\n", paths.back());
+    const auto result = BenchParallel(boards, threads, repeat, options);
+    BenchBranching(boards, repeat, options);
+    BenchDeductions(boards, repeat, options);
+    return result;
+}
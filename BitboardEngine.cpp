@@ -0,0 +1,311 @@
+#include "BitboardEngine.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Bits.h"
+
+namespace Solver
+{
+    //Cell c sits in band c / 27 at bit c % 27, so a band is three rows of nine
+    const uint32_t BandMask = (1u << 27) - 1;
+    const uint32_t RowMask = 0x1FF;
+    //The left box of a band, the other two are this shifted by 3 and 6
+    const uint32_t BoxMask = 0x7u | (0x7u << 9) | (0x7u << 18);
+
+    //Built once, like the layout of the mask engine
+    struct BitboardLayout
+    {
+        //The cells sharing a unit with each cell as a mask per band, not counting the cell itself
+        uint32_t Peers[81][3];
+
+        BitboardLayout()
+        {
+            for (auto cell = 0; cell < 81; ++cell)
+            {
+                const auto x = cell % 9;
+                const auto y = cell / 9;
+                for (auto& band : Peers[cell]) { band = 0; }
+                for (auto other = 0; other < 81; ++other)
+                {
+                    const auto ox = other % 9;
+                    const auto oy = other / 9;
+                    const auto shared = ox == x || oy == y || (ox / 3 == x / 3 && oy / 3 == y / 3);
+                    if (other != cell && shared) { Peers[cell][other / 27] |= 1u << (other % 27); }
+                }
+            }
+        }
+    };
+
+    const BitboardLayout BitboardCells{};
+
+    struct BitboardState
+    {
+        //Cells that can still hold each digit, a cell keeps the bit of the digit placed in it
+        uint32_t Digits[9][3];
+        uint32_t Unsolved[3];
+    };
+
+    struct BitboardSearch
+    {
+        char* Solution;
+        int Limit;
+        int Solutions;
+        int Guesses;
+        //Null when the solve has no limits
+        SolveBudget* Budget;
+        bool Stopped;
+    };
+
+    //The digit has to still be a candidate of the cell
+    void PlaceDigit(BitboardState& state, int digit, int cell)
+    {
+        const auto band = cell / 27;
+        const auto bit = 1u << (cell % 27);
+        auto const& peers = BitboardCells.Peers[cell];
+        for (auto b = 0; b < 3; ++b) { state.Digits[digit][b] &= ~peers[b]; }
+        for (auto d = 0; d < 9; ++d) { state.Digits[d][band] &= ~bit; }
+        state.Digits[digit][band] |= bit;
+        state.Unsolved[band] &= ~bit;
+    }
+
+    //Places naked and hidden singles until there are none left, returns false if the puzzle runs into a contradiction
+    //Naked singles come from counting each open cell's digits once and twice across the nine bitboards of a band.
+    //Hidden singles come from the row, box and column slices of each digit's bitboard, and a digit is only looked at
+    //again once its bitboard differs from settled, a state that had no singles left in it
+    bool Propagate(BitboardState& state, BitboardState const& settled)
+    {
+        uint32_t checked[9][3];
+        memcpy(checked, settled.Digits, sizeof(checked));
+
+        for (;;)
+        {
+            auto placed = false;
+            for (auto band = 0; band < 3; ++band)
+            {
+                auto once = 0u;
+                auto twice = 0u;
+                for (auto d = 0; d < 9; ++d)
+                {
+                    const auto m = state.Digits[d][band];
+                    twice |= once & m;
+                    once |= m;
+                }
+                if (state.Unsolved[band] & ~once) { return false; }
+
+                //A cell with one digit left only has to take it out of its peers, one digit at a time for every such cell
+                const auto singles = state.Unsolved[band] & ~twice;
+                if (!singles) { continue; }
+                for (auto d = 0; d < 9; ++d)
+                {
+                    auto cells = singles & state.Digits[d][band];
+                    if (!cells) { continue; }
+                    const auto placing = cells;
+                    while (cells)
+                    {
+                        auto const& peers = BitboardCells.Peers[band * 27 + (int)LowestBit(cells)];
+                        cells &= cells - 1;
+                        for (auto b = 0; b < 3; ++b) { state.Digits[d][b] &= ~peers[b]; }
+                    }
+                    //Two of them in one unit clear each other
+                    if ((state.Digits[d][band] & placing) != placing) { return false; }
+                }
+                state.Unsolved[band] &= ~singles;
+                placed = true;
+            }
+
+            for (auto d = 0; d < 9; ++d)
+            {
+                auto const& bands = state.Digits[d];
+                if (bands[0] == checked[d][0] && bands[1] == checked[d][1] && bands[2] == checked[d][2]) { continue; }
+                for (auto band = 0; band < 3; ++band) { checked[d][band] = bands[band]; }
+
+                //Folding the nine rows together shows which columns have the digit in only one row, and which in none
+                auto once = 0u;
+                auto twice = 0u;
+                for (auto band = 0; band < 3; ++band)
+                {
+                    for (auto row = 0; row < 27; row += 9)
+                    {
+                        const auto m = (bands[band] >> row) & RowMask;
+                        twice |= once & m;
+                        once |= m;
+                    }
+                }
+                auto contradiction = RowMask & ~once;
+                const auto columns = once & ~twice;
+                const auto columnCells = columns | (columns << 9) | (columns << 18);
+
+                //Every row and box is checked without branching, only the singles found take any work
+                uint32_t hidden[3];
+                for (auto band = 0; band < 3; ++band)
+                {
+                    const auto m = bands[band];
+                    auto singles = m & columnCells;
+                    for (auto shift = 0; shift < 9; shift += 3)
+                    {
+                        const auto row = m & (RowMask << (3 * shift));
+                        const auto box = m & (BoxMask << shift);
+                        contradiction |= (row == 0) | (box == 0);
+                        singles |= (row & (row - 1)) == 0 ? row : 0;
+                        singles |= (box & (box - 1)) == 0 ? box : 0;
+                    }
+                    hidden[band] = singles & state.Unsolved[band];
+                }
+                if (contradiction) { return false; }
+
+                for (auto band = 0; band < 3; ++band)
+                {
+                    auto cells = hidden[band];
+                    while (cells)
+                    {
+                        const auto bit = cells & (0u - cells);
+                        cells ^= bit;
+                        //A single placed before this one can have taken the cell or the digit's place in it
+                        if (!(state.Digits[d][band] & bit)) { return false; }
+                        PlaceDigit(state, d, band * 27 + (int)LowestBit(bit));
+                        placed = true;
+                    }
+                }
+            }
+
+            if (!placed) { return true; }
+        }
+    }
+
+    //The open cell with the fewest candidates, taking the first with two as there are none with fewer after Propagate
+    //Returns -1 once every cell is placed
+    int ChooseCell(BitboardState const& state)
+    {
+        for (auto band = 0; band < 3; ++band)
+        {
+            auto once = 0u;
+            auto twice = 0u;
+            auto thrice = 0u;
+            for (auto d = 0; d < 9; ++d)
+            {
+                const auto m = state.Digits[d][band];
+                thrice |= twice & m;
+                twice |= once & m;
+                once |= m;
+            }
+            const auto pairs = state.Unsolved[band] & twice & ~thrice;
+            if (pairs) { return band * 27 + (int)LowestBit(pairs); }
+        }
+
+        auto best = -1;
+        auto bestCount = 10;
+        for (auto band = 0; band < 3; ++band)
+        {
+            auto cells = state.Unsolved[band];
+            while (cells)
+            {
+                const auto position = (int)LowestBit(cells);
+                cells &= cells - 1;
+                auto count = 0;
+                for (auto d = 0; d < 9; ++d) { count += (int)((state.Digits[d][band] >> position) & 1); }
+                if (count < bestCount)
+                {
+                    best = band * 27 + position;
+                    bestCount = count;
+                }
+            }
+        }
+        return best;
+    }
+
+    void WriteSolution(BitboardState const& state, char* line)
+    {
+        for (auto d = 0; d < 9; ++d)
+        {
+            for (auto band = 0; band < 3; ++band)
+            {
+                auto cells = state.Digits[d][band];
+                while (cells)
+                {
+                    line[band * 27 + (int)LowestBit(cells)] = ValueChar(d + 1);
+                    cells &= cells - 1;
+                }
+            }
+        }
+    }
+
+    //Tries each digit of the chosen cell on a copy, the state itself is the backtrack
+    //The state has no singles left in it, so propagating a guess only looks at the units the guess changes
+    //A digit that has been searched is taken out of the cell, which can leave the cell or others forced
+    //Returns true once there are enough solutions to stop, or the budget ran out
+    bool SearchBitboard(BitboardState& state, BitboardSearch& search)
+    {
+        const auto cell = ChooseCell(state);
+        if (cell < 0)
+        {
+            if (search.Solutions == 0) { WriteSolution(state, search.Solution); }
+            search.Solutions += 1;
+            return search.Solutions >= search.Limit;
+        }
+
+        const auto band = cell / 27;
+        const auto bit = 1u << (cell % 27);
+        for (;;)
+        {
+            auto digit = 0;
+            while (!(state.Digits[digit][band] & bit)) { ++digit; }
+
+            if (search.Budget != nullptr && !search.Budget->Continue(search.Guesses))
+            {
+                search.Stopped = true;
+                return true;
+            }
+            search.Guesses += 1;
+            auto next = state;
+            PlaceDigit(next, digit, cell);
+            if (Propagate(next, state) && SearchBitboard(next, search)) { return true; }
+
+            next = state;
+            state.Digits[digit][band] &= ~bit;
+            if (!Propagate(state, next)) { return false; }
+            //Down to one digit, Propagate has placed it
+            if (!(state.Unsolved[band] & bit)) { return SearchBitboard(state, search); }
+        }
+    }
+
+    SolveStatus SolveBitboard(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses, SolveBudget* budget)
+    {
+        solutions = 0;
+        guesses = 0;
+
+        auto state = BitboardState();
+        for (auto& digit : state.Digits)
+        {
+            for (auto& band : digit) { band = BandMask; }
+        }
+        for (auto& band : state.Unsolved) { band = BandMask; }
+
+        for (auto cell = 0; cell < 81; ++cell)
+        {
+            const auto c = puzzle[cell];
+            const auto v = CharValue(c);
+            if (v >= 1 && v <= 9)
+            {
+                //Only a given of the same digit in a peer takes a digit out before propagation starts
+                if (!(state.Digits[v - 1][cell / 27] & (1u << (cell % 27)))) { return SolveStatus::InvalidInput; }
+                PlaceDigit(state, v - 1, cell);
+            }
+            else if (c != '.' && c != '0') { return SolveStatus::InvalidInput; }
+        }
+        //Every unit counts as changed the first time round
+        auto unsettled = BitboardState();
+        for (auto& digit : unsettled.Digits)
+        {
+            for (auto& band : digit) { band = ~0u; }
+        }
+        if (!Propagate(state, unsettled)) { return SolveStatus::Unsolvable; }
+
+        auto search = BitboardSearch{ solution, solutionLimit < 1 ? 1 : solutionLimit, 0, 0, budget, false };
+        SearchBitboard(state, search);
+        solutions = search.Solutions;
+        guesses = search.Guesses;
+        if (search.Stopped) { return budget->Stopped(); }
+        return solutions > 0 ? SolveStatus::Solved : SolveStatus::Unsolvable;
+    }
+}
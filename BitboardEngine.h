@@ -0,0 +1,13 @@
+#pragma once
+#include "Board.h"
+
+namespace Solver
+{
+	//Solves a 9x9 puzzle of 81 characters in row order with a bitboard per digit
+	//Each digit's candidates are three 27 bit bands of three rows, so placing a digit, finding singles and checking
+	//a unit are a few shifts and ANDs per band, and the whole state is small enough that a guess just copies it
+	//The first solution is written to solution as 81 characters, solution is left alone if there is none
+	//Stops once solutionLimit solutions are found, solutions is how many were, guesses how many guesses it took
+	//Givens that clash are InvalidInput, the same as SetInitialData. A budget, if given, is checked before every guess
+	SolveStatus SolveBitboard(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses, SolveBudget* budget);
+}
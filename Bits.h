@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Solver
+{
+	//Smallest mask type with room for the given number of bits
+	template <int Bits>
+	using MaskFor = typename std::conditional<(Bits <= 16), uint16_t,
+		typename std::conditional<(Bits <= 32), uint32_t, uint64_t>::type>::type;
+
+	//Position of the lowest set bit, mask must not be zero
+	template <typename Mask>
+	inline unsigned long LowestBit(Mask mask)
+	{
+#ifdef _MSC_VER
+		unsigned long pos;
+		if (sizeof(Mask) > 4) { _BitScanForward64(&pos, (unsigned long long)mask); }
+		else { _BitScanForward(&pos, (unsigned long)mask); }
+		return pos;
+#else
+		if (sizeof(Mask) > 4) { return (unsigned long)__builtin_ctzll((unsigned long long)mask); }
+		return (unsigned long)__builtin_ctz((unsigned int)mask);
+#endif
+	}
+
+	template <typename Mask>
+	inline int CountBits(Mask mask)
+	{
+#ifdef _MSC_VER
+		if (sizeof(Mask) > 4) { return (int)__popcnt64((unsigned long long)mask); }
+		return (int)__popcnt((unsigned int)mask);
+#else
+		if (sizeof(Mask) > 4) { return __builtin_popcountll((unsigned long long)mask); }
+		return __builtin_popcount((unsigned int)mask);
+#endif
+	}
+}
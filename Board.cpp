@@ -1,361 +1,915 @@
-#include <stdio.h>
-#include <cmath>
-#include <algorithm>
-#include <intrin.h>
-#include <deque>
-#include <stack>
-
-#include "Board.h"
-#include "ConsoleHelper.h"
-
-namespace Solver
-{
-    unsigned short ToBit(int v)
-    {
-        return (unsigned short)(1u << (v - 1));
-    }
-    unsigned short GenMask(int v)
-    {
-        //Bit position is shifted by one since 0 isn't counted
-        return (~ToBit(v)) & 0x1ff;
-    }
-
-    //Initialize everything to ones except for board, which is initialized empty
-    Board::Board()
-        : m_lastEmptyRow(0)
-    {
-        std::memset(m_board, 0, sizeof(m_board));
-        std::fill(std::begin(m_rowMask), std::end(m_rowMask), 0x1ff);
-        std::fill(std::begin(m_colMask), std::end(m_colMask), 0x1ff);
-        std::memset(m_boxMask, 0xff, sizeof(m_boxMask));
-        std::memset(m_cellMask, 0xff, sizeof(m_cellMask));
-    }
-
-    //Copy is an exact memory copy
-    Board::Board(Board const& other)
-        : m_lastEmptyRow(other.m_lastEmptyRow)
-    {
-        std::memcpy(m_board, other.m_board, sizeof(m_board));
-        std::memcpy(m_rowMask, other.m_rowMask, sizeof(m_rowMask));
-        std::memcpy(m_colMask, other.m_colMask, sizeof(m_colMask));
-        std::memcpy(m_boxMask, other.m_boxMask, sizeof(m_boxMask));
-        std::memcpy(m_cellMask, other.m_cellMask, sizeof(m_cellMask));
-    }
-
-    //Check that no empty spots remain on the board
-    bool Board::IsSolved() const
-    {
-        for (auto x = 0; x < 9; ++x)
-        {
-            if (std::count(m_board[x], m_board[x] + 9, 0) != 0) { return false; }
-        }
-        return true;
-    }
-
-    //This is a weak check. If the original board contains an error, this won't detect it.
-    bool Board::IsValid() const
-    {
-        for (auto x = 0; x < 9; ++x)
-        {
-            for (auto y = 0; y < 9; ++y)
-            {
-                if (m_board[x][y] == 0 && GetCellMask(x, y) == 0) { return false; }
-            }
-        }
-
-        return true;
-    }
-
-    //Use the ConsoleHelper to read in the board, either from pre-defined strings or from the console
-    Board Board::GetBoard(int board)
-    {
-        auto b = Board();
-        PrintEmptyBoard();
-
-        auto setCursor = [&](int x, int y, int v) { b.InitCell(x, y, v); };
-        ReadBoard(setCursor, board);
-
-        return b;
-    }
-
-    //Initialize all the masks on the board
-    //Also checks to make sure initial input board is valid
-    bool Board::SetInitialData()
-    {
-        auto valid = true;
-        std::deque<CellGuess> nonEmptyCells;
-        std::deque<Cell> emptyCells;
-
-        for (auto y = 0; y < 9; ++y)
-        {
-            for (auto x = 0; x < 9; ++x)
-            {
-                const auto cell = m_board[x][y];
-                if (cell == 0) { emptyCells.push_back({ x, y }); }
-                else { nonEmptyCells.emplace_back(x,y,cell); }
-            }
-        }
-
-        for (auto const& cell : nonEmptyCells)
-        {
-            //For the board to be valid, all the masks must have the value available to be cleared
-            const auto bit = ToBit(cell.V);
-            valid &= ((m_rowMask[cell.Y] & m_colMask[cell.X] & m_boxMask[cell.X / 3][cell.Y / 3] & bit) != 0);
-
-            //Clear the bit now that we checked
-            const auto mask = GenMask(cell.V);
-            m_rowMask[cell.Y] &= mask;
-            m_colMask[cell.X] &= mask;
-            m_boxMask[cell.X / 3][cell.Y / 3] &= mask;
-            m_cellMask[cell.X][cell.Y] = 0;
-        }
-
-        for (auto const& cell : emptyCells)
-        {
-            m_cellMask[cell.X][cell.Y] &= m_colMask[cell.X] & m_rowMask[cell.Y] & m_boxMask[cell.X / 3][cell.Y / 3];
-        }
-        m_lastEmptyRow = emptyCells.front().Y;
-        return valid;
-    }
-
-    //Simply sets the cell but doesn't update the masks
-    void Board::InitCell(int x, int y, int v)
-    {
-        m_board[x][y] = v;
-        SetCursor(x, y, v);
-    }
-
-    //Sets a cell and updates the mask
-    //This is important since masks aren't updated anywhere else
-    void Board::SetCell(int x, int y, int v)
-    {
-        InitCell(x, y, v);
-
-        const auto mask = GenMask(v);
-        m_colMask[x] &= mask;
-        m_rowMask[y] &= mask;
-        m_boxMask[x / 3][y / 3] &= mask;
-        m_cellMask[x][y] = 0;
-    }
-
-    //Apply all masks to figure out what numbers are valid for a cell
-    unsigned short Board::GetCellMask(int x, int y) const
-    {
-        return m_cellMask[x][y] & m_colMask[x] & m_rowMask[y] & m_boxMask[x / 3][y / 3];
-    }
-
-    unsigned short Board::GetRowMask(int y) const
-    {
-        unsigned short mask = 0;
-        for (auto x = 0; x < 9; ++x)
-        {
-            mask |= m_cellMask[x][y];
-        }
-        return mask;
-    }
-
-    unsigned short Board::GetColMask(int x) const
-    {
-        unsigned short mask = 0;
-        for (auto y = 0; y < 9; ++y)
-        {
-            mask |= m_cellMask[x][y];
-        }
-        return mask;
-    }
-
-    unsigned short Board::GetBoxMask(int bx, int by) const
-    {
-        unsigned short mask = 0;
-        const auto offsetX = bx * 3;
-        const auto offsetY = by * 3;
-        for (auto y = offsetY; y < offsetY + 3; ++y)
-        {
-            for (auto x = offsetX; x < offsetX + 3; ++x)
-            {
-                mask |= m_cellMask[x][y];
-            }
-        }
-        return mask;
-    }
-
-    //Continue brute force through each cell seeing if the mask indicates the cell is known
-    //Every time a cell is updated, have to restart the process again
-    //Also check if a cell needs a number but mask indicates no number can be placed
-    bool Board::SolveKnown()
-    {
-        auto newInfo = true;
-        while (newInfo)
-        {
-            newInfo = false;
-            for (auto x = 0; x < 9; ++x)
-            {
-                for (auto y = 0; y < 9; ++y)
-                {
-                    //If cell filled, continue
-                    if (m_board[x][y] != 0) { continue; }
-
-                    //If cell has no available numbers, fail
-                    const auto origCellMask = GetCellMask(x, y);
-                    if (origCellMask == 0) { return false; }
-
-                    //If cell has only one number to place, set that number
-                    unsigned long pos;
-                    _BitScanForward(&pos, origCellMask);
-                    auto shiftedMask = origCellMask >> pos;
-                    if (shiftedMask == 1)
-                    {
-                        newInfo = true;
-                        SetCell(x, y, pos + 1);
-                        continue;
-                    }
-
-                    //Finally, check if cell has any numbers unique to it in row/col/box
-                    //Clear the cell mask temporarily so other functions don't include this cell
-                    m_cellMask[x][y] = 0;
-
-                    //Unique numbers are those that don't appear anywhere else in the region but do appear in current cell
-                    const auto uniqueRow = (GetRowMask(y) & origCellMask) ^ origCellMask;
-                    const auto uniqueCol = (GetColMask(x) & origCellMask) ^ origCellMask;
-                    const auto uniqueBox = (GetBoxMask(x / 3, y / 3) & origCellMask) ^ origCellMask;
-                    //Combine all the masks together since there should only be one unique value anyway
-                    const auto uniqueAll = uniqueRow | uniqueCol | uniqueBox;
-                    //Restore the original cell mask
-                    m_cellMask[x][y] = origCellMask;
-
-                    //If nothing unique about this cell, move on
-                    if (uniqueAll == 0) { continue; }
-
-                    //Otherwise find a bit that has been set
-                    _BitScanForward(&pos, uniqueAll);
-                    shiftedMask = uniqueAll >> pos;
-                    //If one bit is found, then we can set the cell
-                    //If more than one bit is found, then it is invalid
-                    if (shiftedMask == 1)
-                    {
-                        newInfo = true;
-                        SetCell(x, y, pos + 1);
-                    }
-                    else
-                    {
-                        return false;
-                    }
-                }
-            }
-        }
-
-        return true;
-    }
-
-    //Find an empty cell on the board
-    Cell Board::FindEmptyCell()
-    {
-        for (auto y = m_lastEmptyRow; y < 9; ++y)
-        {
-            for (auto x = 0; x < 9; ++x)
-            {
-                if (m_board[x][y] == 0)
-                {
-                    m_lastEmptyRow = y;
-                    return { x,y };
-                }
-            }
-        }
-        throw std::exception("No empty cell found");
-    }
-
-    //Find an empty cell and guess one of the valid numbers for that cell
-    CellGuess Board::MakeGuess()
-    {
-        auto cell = FindEmptyCell();
-        const auto cellMask = GetCellMask(cell.X, cell.Y);
-
-        unsigned long guess;
-        _BitScanForward(&guess, cellMask);
-        SetCell(cell.X, cell.Y, guess + 1);
-        return CellGuess(cell.X, cell.Y, (int)guess + 1);
-    }
-
-    //If a guess doesn't work, clear the bit for that guess in that cell
-    void Board::ClearGuess(CellGuess const& guess)
-    {
-        m_cellMask[guess.X][guess.Y] &= GenMask(guess.V);
-        PrintBoard();
-    }
-
-    //Print every value in the board
-    void Board::PrintBoard() const
-    {
-        for (auto x = 0; x < 9; ++x)
-        {
-            for (auto y = 0; y < 9; ++y)
-            {
-                SetCursor(x, y, m_board[x][y]);
-            }
-        }
-    }
-
-    struct Move
-    {
-        Board Board;
-        CellGuess Guess;
-    };
-
-    //SolveBoard avoids recursion since it could go fairly deep
-    //Instead, use a stack to keep copies of the board on the heap
-    //Copy the board each time a guess is made so we can go back if it is wrong
-    //Turned out to be surprisingly simple algorithm:
-    // 1. Make a guess
-    // 2. Solve all the known cells
-    // 3. If it proves invalid, then clear the guess on the previou board
-    // 4. If the previous build is now invalid, pop it, and clear its guess on the previous board
-    // 5. Otherwise, push board on the stack and loop again if it isn't solved
-    void SolveBoard(Board const& board)
-    {
-        std::stack<Move> boardStack;
-        boardStack.push({ board, Solver::CellGuess(0, 0, 0) });
-        auto guesses = 0;
-
-        if (!boardStack.top().Board.SetInitialData())
-        {
-            SetCursorEnd();
-            printf("Invalid input\n");
-            return;
-        }
-        boardStack.top().Board.SolveKnown();
-
-        while (!boardStack.empty() && !boardStack.top().Board.IsSolved())
-        {
-            auto tempBoard = boardStack.top();
-            auto guess = tempBoard.Board.MakeGuess();
-            guesses += 1;
-
-            if (!tempBoard.Board.SolveKnown())
-            {
-                boardStack.top().Board.ClearGuess(guess);
-                while (!boardStack.top().Board.IsValid())
-                {
-                    guess = boardStack.top().Guess;
-                    boardStack.pop();
-                    boardStack.top().Board.ClearGuess(guess);
-                }
-            }
-            else
-            {
-                boardStack.push({ tempBoard.Board, guess });
-            }
-        }
-
-        if (boardStack.empty())
-        {
-            SetCursorEnd();
-            printf("Failed to solve board after %d guesses\n", guesses);
-        }
-        else
-        {
-            boardStack.top().Board.PrintBoard();
-            SetCursorEnd();
-            printf("Solved board after %d guesses\n", guesses);
-        }
-    }
-}
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+
+#include "Bits.h"
+#include "Board.h"
+
+namespace Solver
+{
+    template <int BoxSize>
+    using MaskOf = typename BasicBoard<BoxSize>::Mask;
+
+    template <int BoxSize>
+    MaskOf<BoxSize> ToBit(int v)
+    {
+        return (MaskOf<BoxSize>)((MaskOf<BoxSize>)1 << (v - 1));
+    }
+
+    //Every value of the grid
+    template <int BoxSize>
+    MaskOf<BoxSize> AllValues()
+    {
+        return (MaskOf<BoxSize>)(~0ull >> (64 - BasicBoard<BoxSize>::Size));
+    }
+
+    template <int BoxSize>
+    MaskOf<BoxSize> GenMask(int v)
+    {
+        //Bit position is shifted by one since 0 isn't counted
+        return (MaskOf<BoxSize>)(~ToBit<BoxSize>(v) & AllValues<BoxSize>());
+    }
+
+    //Values are written 1-9, then A-Z for the larger grids
+    char ValueChar(int v)
+    {
+        return (char)(v <= 9 ? '0' + v : 'A' + v - 10);
+    }
+
+    //Returns 0 for anything that isn't a value
+    int CharValue(char c)
+    {
+        if (c >= '1' && c <= '9') { return c - '0'; }
+        if (c >= 'A' && c <= 'Z') { return c - 'A' + 10; }
+        if (c >= 'a' && c <= 'z') { return c - 'a' + 10; }
+        return 0;
+    }
+
+    //Cells are numbered in row order, units are the rows, then the columns, then the boxes
+    //Built once so propagation only ever walks the cells it needs to
+    template <int BoxSize>
+    struct Layout
+    {
+        using Grid = BasicBoard<BoxSize>;
+        using CellIndex = typename Grid::CellIndex;
+        static const int Size = Grid::Size;
+
+        unsigned char Units[Grid::CellCount][3];
+        //Where the cell sits within each of its units
+        unsigned char Places[Grid::CellCount][3];
+        CellIndex UnitCells[Grid::UnitCount][Size];
+        CellIndex Peers[Grid::CellCount][Grid::PeerCount];
+
+        Layout()
+        {
+            for (auto cell = 0; cell < Grid::CellCount; ++cell)
+            {
+                const auto x = cell % Size;
+                const auto y = cell / Size;
+                const auto box = (y / BoxSize) * BoxSize + x / BoxSize;
+                Units[cell][0] = (unsigned char)y;
+                Units[cell][1] = (unsigned char)(Size + x);
+                Units[cell][2] = (unsigned char)(2 * Size + box);
+
+                Places[cell][0] = (unsigned char)x;
+                Places[cell][1] = (unsigned char)y;
+                Places[cell][2] = (unsigned char)((y % BoxSize) * BoxSize + x % BoxSize);
+
+                UnitCells[y][x] = (CellIndex)cell;
+                UnitCells[Size + x][y] = (CellIndex)cell;
+                UnitCells[2 * Size + box][Places[cell][2]] = (CellIndex)cell;
+            }
+
+            //Peers are every other cell sharing a unit, each listed once
+            for (auto cell = 0; cell < Grid::CellCount; ++cell)
+            {
+                auto count = 0;
+                for (auto other = 0; other < Grid::CellCount; ++other)
+                {
+                    if (other == cell) { continue; }
+                    const auto shared = Units[cell][0] == Units[other][0]
+                        || Units[cell][1] == Units[other][1]
+                        || Units[cell][2] == Units[other][2];
+                    if (shared) { Peers[cell][count++] = (CellIndex)other; }
+                }
+            }
+        }
+    };
+
+    template <int BoxSize>
+    const Layout<BoxSize> Cells{};
+
+    //Places given to a digit once it is placed in a unit
+    //These bits are past the cells of a unit so removing candidates never makes it look like a single or a contradiction
+    template <int BoxSize>
+    typename BasicBoard<BoxSize>::PlaceMask PlacedMarker()
+    {
+        return (typename BasicBoard<BoxSize>::PlaceMask)((typename BasicBoard<BoxSize>::PlaceMask)3 << BasicBoard<BoxSize>::Size);
+    }
+
+    //Initialize everything to ones except for board, which is initialized empty
+    template <int BoxSize>
+    BasicBoard<BoxSize>::BasicBoard()
+        : m_queueSize(0)
+        , m_valid(true)
+#if SUDOKU_STATS
+        , m_stats(nullptr)
+#endif
+    {
+        std::memset(m_board, 0, sizeof(m_board));
+        std::fill(std::begin(m_empty), std::end(m_empty), ~(uint64_t)0);
+        if (CellCount % 64 != 0) { m_empty[EmptyWords - 1] = ((uint64_t)1 << (CellCount % 64)) - 1; }
+        std::fill(std::begin(m_unitMask), std::end(m_unitMask), AllValues<BoxSize>());
+        std::fill(std::begin(m_cellMask), std::end(m_cellMask), AllValues<BoxSize>());
+        std::fill(&m_digitPlaces[0][0], &m_digitPlaces[0][0] + UnitCount * Size, (PlaceMask)AllValues<BoxSize>());
+    }
+
+    //Copy is an exact memory copy, only the used part of the queue is copied
+    template <int BoxSize>
+    BasicBoard<BoxSize>::BasicBoard(BasicBoard const& other)
+        : m_queueSize(other.m_queueSize)
+        , m_valid(other.m_valid)
+#if SUDOKU_STATS
+        , m_stats(other.m_stats)
+#endif
+    {
+        std::memcpy(m_board, other.m_board, sizeof(m_board));
+        std::memcpy(m_unitMask, other.m_unitMask, sizeof(m_unitMask));
+        std::memcpy(m_cellMask, other.m_cellMask, sizeof(m_cellMask));
+        std::memcpy(m_digitPlaces, other.m_digitPlaces, sizeof(m_digitPlaces));
+        std::memcpy(m_queue, other.m_queue, m_queueSize * sizeof(m_queue[0]));
+        std::memcpy(m_empty, other.m_empty, sizeof(m_empty));
+    }
+
+    template <int BoxSize>
+    BasicBoard<BoxSize>& BasicBoard<BoxSize>::operator=(BasicBoard const& other)
+    {
+        m_queueSize = other.m_queueSize;
+        m_valid = other.m_valid;
+#if SUDOKU_STATS
+        m_stats = other.m_stats;
+#endif
+        std::memcpy(m_board, other.m_board, sizeof(m_board));
+        std::memcpy(m_unitMask, other.m_unitMask, sizeof(m_unitMask));
+        std::memcpy(m_cellMask, other.m_cellMask, sizeof(m_cellMask));
+        std::memcpy(m_digitPlaces, other.m_digitPlaces, sizeof(m_digitPlaces));
+        std::memcpy(m_queue, other.m_queue, m_queueSize * sizeof(m_queue[0]));
+        std::memcpy(m_empty, other.m_empty, sizeof(m_empty));
+        return *this;
+    }
+
+    //Check that no empty spots remain on the board
+    template <int BoxSize>
+    bool BasicBoard<BoxSize>::IsSolved() const
+    {
+        auto empty = m_empty[0];
+        for (auto i = 1; i < EmptyWords; ++i) { empty |= m_empty[i]; }
+        return empty == 0;
+    }
+
+    //Contradictions are caught as candidates are removed, so this is just the flag they set
+    //A cell without candidates or a digit with nowhere to go in a unit both make the board invalid
+    template <int BoxSize>
+    bool BasicBoard<BoxSize>::IsValid() const
+    {
+        return m_valid;
+    }
+
+    //Read a board from a single line of cells in row order, '.' or '0' for blanks
+    //Values past 9 are the letters from A, so a 16x16 board uses 1-9 and A-G
+    //Anything after the last cell is ignored so annotated corpora can be fed directly
+    template <int BoxSize>
+    bool BasicBoard<BoxSize>::FromLine(std::string const& line, BasicBoard& board)
+    {
+        if (line.size() < (size_t)CellCount) { return false; }
+        return FromLine(line.data(), board);
+    }
+
+    template <int BoxSize>
+    bool BasicBoard<BoxSize>::FromLine(const char* line, BasicBoard& board)
+    {
+        board = BasicBoard();
+        for (auto i = 0; i < CellCount; ++i)
+        {
+            const auto cell = line[i];
+            const auto v = CharValue(cell);
+            if (v >= 1 && v <= Size) { board.InitCell(i % Size, i / Size, v); }
+            else if (cell != '.' && cell != '0') { return false; }
+        }
+        return true;
+    }
+
+    //Write the board as CellCount cells in row order, same format FromLine reads
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::ToLine(char* line) const
+    {
+        for (auto i = 0; i < CellCount; ++i)
+        {
+            const auto cell = m_board[i];
+            line[i] = cell ? ValueChar(cell) : '.';
+        }
+    }
+
+    template <int BoxSize>
+    int BasicBoard<BoxSize>::GetCell(int x, int y) const
+    {
+        return m_board[y * Size + x];
+    }
+
+    //Initialize all the masks on the board in one pass over the givens
+    //Also checks to make sure initial input board is valid
+    //Every single and contradiction found here is left for SolveKnown, which only works from then on incrementally
+    template <int BoxSize>
+    bool BasicBoard<BoxSize>::SetInitialData()
+    {
+        auto const& layout = Cells<BoxSize>;
+        m_queueSize = 0;
+        m_valid = true;
+        std::fill(std::begin(m_unitMask), std::end(m_unitMask), AllValues<BoxSize>());
+        std::memset(m_digitPlaces, 0, sizeof(m_digitPlaces));
+
+        for (auto cell = 0; cell < CellCount; ++cell)
+        {
+            const auto v = m_board[cell];
+            if (v == 0) { continue; }
+
+            //For the board to be valid, all the masks must have the value available to be cleared
+            const auto bit = ToBit<BoxSize>(v);
+            auto const& units = layout.Units[cell];
+            if ((m_unitMask[units[0]] & m_unitMask[units[1]] & m_unitMask[units[2]] & bit) == 0) { return false; }
+
+            //Clear the bit now that we checked
+            const auto mask = GenMask<BoxSize>(v);
+            m_unitMask[units[0]] &= mask;
+            m_unitMask[units[1]] &= mask;
+            m_unitMask[units[2]] &= mask;
+        }
+
+        for (auto cell = 0; cell < CellCount; ++cell)
+        {
+            if (m_board[cell] != 0)
+            {
+                m_cellMask[cell] = 0;
+                continue;
+            }
+
+            auto const& units = layout.Units[cell];
+            const auto mask = (Mask)(m_unitMask[units[0]] & m_unitMask[units[1]] & m_unitMask[units[2]]);
+            m_cellMask[cell] = mask;
+            if (mask == 0) { m_valid = false; }
+            else if ((mask & (mask - 1)) == 0) { Enqueue(cell, (int)LowestBit(mask) + 1); }
+
+            auto row = m_digitPlaces[units[0]];
+            auto col = m_digitPlaces[units[1]];
+            auto box = m_digitPlaces[units[2]];
+            const auto rowPlace = (PlaceMask)((PlaceMask)1 << layout.Places[cell][0]);
+            const auto colPlace = (PlaceMask)((PlaceMask)1 << layout.Places[cell][1]);
+            const auto boxPlace = (PlaceMask)((PlaceMask)1 << layout.Places[cell][2]);
+            for (auto bits = mask; bits != 0; bits &= bits - 1)
+            {
+                const auto digit = LowestBit(bits);
+                row[digit] |= rowPlace;
+                col[digit] |= colPlace;
+                box[digit] |= boxPlace;
+            }
+        }
+
+        //Digits with only one home in a unit are hidden singles, ones with no home at all are a contradiction
+        for (auto unit = 0; unit < UnitCount; ++unit)
+        {
+            for (auto bits = (Mask)(~m_unitMask[unit] & AllValues<BoxSize>()); bits != 0; bits &= bits - 1)
+            {
+                m_digitPlaces[unit][LowestBit(bits)] = PlacedMarker<BoxSize>();
+            }
+            for (auto bits = m_unitMask[unit]; bits != 0; bits &= bits - 1)
+            {
+                const auto digit = (int)LowestBit(bits);
+                const auto places = m_digitPlaces[unit][digit];
+                if (places == 0) { m_valid = false; }
+                else if ((places & (places - 1)) == 0) { Enqueue(layout.UnitCells[unit][LowestBit(places)], digit + 1); }
+            }
+        }
+
+        return true;
+    }
+
+    //Simply sets the cell but doesn't update the masks
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::InitCell(int x, int y, int v)
+    {
+        const auto cell = y * Size + x;
+        m_board[cell] = (char)v;
+        m_empty[cell / 64] &= ~((uint64_t)1 << (cell % 64));
+    }
+
+    //Remember a cell that can only hold one value, SolveKnown places it later
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::Enqueue(int cell, int v)
+    {
+        m_queue[m_queueSize++] = { (CellIndex)cell, (unsigned char)v };
+    }
+
+    //The cell can no longer hold v, so take it out of the places v can go in each of its units
+    //A digit left with one place is a hidden single and one left with none is a contradiction
+    //Digits already placed in a unit carry PlacedMarker so they never look like either
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::RemovePlace(int cell, int v)
+    {
+        auto const& layout = Cells<BoxSize>;
+        auto const& units = layout.Units[cell];
+        auto const& places = layout.Places[cell];
+        for (auto i = 0; i < 3; ++i)
+        {
+            const auto remaining = m_digitPlaces[units[i]][v - 1] &= (PlaceMask)~((PlaceMask)1 << places[i]);
+            if (remaining & (remaining - 1)) { continue; }
+
+            if (remaining == 0) { m_valid = false; }
+            else { Enqueue(layout.UnitCells[units[i]][LowestBit(remaining)], v); }
+        }
+    }
+
+    //Take v out of a cell's candidates and out of the places v can go in its units
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::Eliminate(int cell, int v)
+    {
+        if ((m_cellMask[cell] & ToBit<BoxSize>(v)) == 0) { return; }
+
+        const auto mask = m_cellMask[cell] &= GenMask<BoxSize>(v);
+        if (mask == 0) { m_valid = false; }
+        else if ((mask & (mask - 1)) == 0) { Enqueue(cell, (int)LowestBit(mask) + 1); }
+
+        RemovePlace(cell, v);
+    }
+
+    //Sets a cell and updates the masks
+    //Only the units and peers of the cell are touched, anything that becomes known goes on the queue
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::PlaceCell(int cell, int v)
+    {
+        using PeerMask = MaskFor<PeerCount>;
+        auto const& layout = Cells<BoxSize>;
+        m_board[cell] = (char)v;
+        m_empty[cell / 64] &= ~((uint64_t)1 << (cell % 64));
+
+        const auto bit = ToBit<BoxSize>(v);
+        auto others = (Mask)(m_cellMask[cell] & GenMask<BoxSize>(v));
+        m_cellMask[cell] = 0;
+
+        auto const& units = layout.Units[cell];
+        for (auto unit : units)
+        {
+            m_unitMask[unit] &= (Mask)~bit;
+            m_digitPlaces[unit][v - 1] = PlacedMarker<BoxSize>();
+        }
+
+        //The cell no longer offers its other candidates to its units
+        while (others)
+        {
+            const auto other = (int)LowestBit(others) + 1;
+            others &= others - 1;
+            RemovePlace(cell, other);
+        }
+
+        //Find the peers that still have v first, only those need the rest of the work
+        //Keeps the branch on each peer out of the loop since it is close to a coin flip
+        auto const& peers = layout.Peers[cell];
+        PeerMask affected = 0;
+        for (auto i = 0; i < PeerCount; ++i)
+        {
+            affected |= (PeerMask)((m_cellMask[peers[i]] & bit) != 0) << i;
+        }
+        for (; affected != 0; affected &= affected - 1)
+        {
+            Eliminate(peers[LowestBit(affected)], v);
+        }
+    }
+
+    //Sets a cell from its x/y position
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::SetCell(int x, int y, int v)
+    {
+        PlaceCell(y * Size + x, v);
+    }
+
+    //Work through the queue of cells that can only hold one value
+    //Placing one only looks at its peers and units, which may queue up more
+    //Fails as soon as anything has no candidates left
+    template <int BoxSize>
+    bool BasicBoard<BoxSize>::SolveKnown()
+    {
+        while (m_valid && m_queueSize > 0)
+        {
+            const auto next = m_queue[--m_queueSize];
+            const auto current = m_board[next.Cell];
+#if SUDOKU_STATS
+            if (m_stats) { m_stats->SolveKnownIterations += 1; }
+#endif
+            if (current != 0)
+            {
+                //Already placed, fine as long as it agrees
+                if (current != next.Value) { m_valid = false; }
+                continue;
+            }
+            if ((m_cellMask[next.Cell] & ToBit<BoxSize>(next.Value)) == 0)
+            {
+                m_valid = false;
+                continue;
+            }
+
+#if SUDOKU_STATS
+            //A cell down to one candidate counts as a naked single even if it was queued as a hidden one
+            if (m_stats)
+            {
+                const auto mask = m_cellMask[next.Cell];
+                if ((mask & (mask - 1)) == 0) { m_stats->Singles += 1; }
+                else { m_stats->HiddenSingles += 1; }
+            }
+#endif
+            PlaceCell(next.Cell, next.Value);
+        }
+
+        return m_valid;
+    }
+
+    template <int BoxSize>
+    typename BasicBoard<BoxSize>::Mask BasicBoard<BoxSize>::GetCandidates(int cell) const
+    {
+        return m_cellMask[cell];
+    }
+
+    template <int BoxSize>
+    typename BasicBoard<BoxSize>::Mask BasicBoard<BoxSize>::GetPlaces(int unit, int v) const
+    {
+        //Placed digits only carry PlacedMarker, which sits above the place bits
+        return (Mask)(m_digitPlaces[unit][v - 1] & AllValues<BoxSize>());
+    }
+
+    template <int BoxSize>
+    typename BasicBoard<BoxSize>::CellIndex const* BasicBoard<BoxSize>::GetPeers(int cell)
+    {
+        return Cells<BoxSize>.Peers[cell];
+    }
+
+    template <int BoxSize>
+    typename BasicBoard<BoxSize>::CellIndex const* BasicBoard<BoxSize>::GetUnitCells(int unit)
+    {
+        return Cells<BoxSize>.UnitCells[unit];
+    }
+
+    //The lowest bit of the first word with any left is the first empty cell
+    template <int BoxSize>
+    Cell BasicBoard<BoxSize>::FindEmptyCell() const
+    {
+        for (auto i = 0; i < EmptyWords; ++i)
+        {
+            if (m_empty[i] != 0)
+            {
+                const auto cell = i * 64 + (int)LowestBit(m_empty[i]);
+                return { cell % Size, cell / Size };
+            }
+        }
+        return { -1, -1 };
+    }
+
+    template <int BoxSize>
+    uint64_t BasicBoard<BoxSize>::GetEmptyCells(int word) const
+    {
+        return m_empty[word];
+    }
+
+    //Let the strategy pick a cell and one of its candidates, then place it
+    template <int BoxSize>
+    CellGuess BasicBoard<BoxSize>::MakeGuess(BasicBranchStrategy<BoxSize> const& strategy)
+    {
+        const auto guess = strategy.Choose(*this);
+        SetCell(guess.X, guess.Y, guess.V);
+        return guess;
+    }
+
+    //If a guess doesn't work, clear the bit for that guess in that cell
+    //Then place whatever that forces, so every later guess from this board starts from there
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::ClearGuess(CellGuess const& guess)
+    {
+        Eliminate(guess.Y * Size + guess.X, guess.V);
+        SolveKnown();
+    }
+
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::RemoveCandidate(int cell, int v)
+    {
+        Eliminate(cell, v);
+    }
+
+    template <int BoxSize>
+    void BasicBoard<BoxSize>::SetStats(SolveStats* stats)
+    {
+#if SUDOKU_STATS
+        m_stats = stats;
+#else
+        (void)stats;
+#endif
+    }
+
+    //Adds the time until it goes out of scope to a counter, does nothing without one or with stats compiled out
+    class StatTimer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit StatTimer(long long* total)
+            : m_total(SUDOKU_STATS ? total : nullptr)
+            , m_begin(m_total ? Clock::now() : Clock::time_point())
+        {
+        }
+
+        ~StatTimer()
+        {
+            if (m_total) { *m_total += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_begin).count(); }
+        }
+
+    private:
+        long long* m_total;
+        Clock::time_point m_begin;
+    };
+
+    long long* PropagationTime(SolveStats* stats)
+    {
+        return stats ? &stats->PropagationNs : nullptr;
+    }
+
+    //Convenience for one-off solves, the stack's slots are allocated here every time
+    template <int BoxSize>
+    SolveStatus Solve(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& guesses, BasicBoardObserver<BoxSize>* observer)
+    {
+        BasicMoveStack<BoxSize> boardStack;
+        return Solve<BoxSize>(board, solution, guesses, boardStack, BasicSolveOptions<BoxSize>(), observer);
+    }
+
+    template <int BoxSize>
+    BasicMoveStack<BoxSize>::BasicMoveStack()
+        : m_moves(new BasicMove<BoxSize>[Capacity])
+        , m_bottom(0)
+        , m_top(0)
+        , m_copies(0)
+    {
+    }
+
+    template <int BoxSize>
+    void BasicMoveStack<BoxSize>::Reset(BasicBoard<BoxSize> const& board)
+    {
+        m_moves[0].Board = board;
+        m_moves[0].Guess = CellGuess();
+        m_bottom = 0;
+        m_top = 1;
+        m_copies = 1;
+    }
+
+    template <int BoxSize>
+    bool BasicMoveStack<BoxSize>::Empty() const
+    {
+        return m_top == m_bottom;
+    }
+
+    template <int BoxSize>
+    int BasicMoveStack<BoxSize>::Size() const
+    {
+        return m_top - m_bottom;
+    }
+
+    template <int BoxSize>
+    BasicMove<BoxSize>& BasicMoveStack<BoxSize>::Top()
+    {
+        return m_moves[m_top - 1];
+    }
+
+    template <int BoxSize>
+    BasicMove<BoxSize>& BasicMoveStack<BoxSize>::operator[](int level)
+    {
+        return m_moves[m_bottom + level];
+    }
+
+    template <int BoxSize>
+    BasicMove<BoxSize>& BasicMoveStack<BoxSize>::PushCopy()
+    {
+        auto& next = m_moves[m_top];
+        next.Board = m_moves[m_top - 1].Board;
+        m_top += 1;
+        m_copies += 1;
+        return next;
+    }
+
+    template <int BoxSize>
+    void BasicMoveStack<BoxSize>::Pop()
+    {
+        m_top -= 1;
+    }
+
+    template <int BoxSize>
+    void BasicMoveStack<BoxSize>::DropBottom()
+    {
+        m_bottom += 1;
+    }
+
+    template <int BoxSize>
+    long long BasicMoveStack<BoxSize>::Copies() const
+    {
+        return m_copies;
+    }
+
+    //Pop boards that have run out of guesses, clearing the guess that led to each one from the board below
+    template <int BoxSize>
+    void Backtrack(BasicMoveStack<BoxSize>& boardStack, SolveStats* stats)
+    {
+        while (!boardStack.Top().Board.IsValid())
+        {
+            const auto guess = boardStack.Top().Guess;
+            boardStack.Pop();
+            if (SUDOKU_STATS && stats) { stats->Backtracks += 1; }
+            //Every guess on the first board failed, so there is no solution
+            if (boardStack.Empty()) { break; }
+            boardStack.Top().Board.ClearGuess(guess);
+        }
+    }
+
+    //Search avoids recursion since it could go fairly deep
+    //Instead, use a stack to keep copies of the board in slots set aside up front
+    //Copy the board each time a guess is made so we can go back if it is wrong
+    //Turned out to be surprisingly simple algorithm:
+    // 1. Run any enabled deductions on the top board, backtracking as in step 5 if they prove it invalid
+    // 2. Make a guess on a copy of the top board
+    // 3. Solve all the known cells
+    // 4. If it proves invalid, then drop the copy and clear the guess on the previous board
+    // 5. If the previous build is now invalid, pop it, and clear its guess on the previous board
+    // 6. Otherwise, keep the copy on the stack and loop again if it isn't solved
+    //The bottom board must already be set up, the solution is left on top of the stack
+    template <int BoxSize>
+    SolveStatus Search(BasicMoveStack<BoxSize>& boardStack, int& guesses, BasicSolveOptions<BoxSize> const& options,
+        BasicBoardObserver<BoxSize>* observer, BasicSearchMonitor<BoxSize>* monitor, SolveStats* stats)
+    {
+        auto const& strategy = *options.Strategy;
+        while (!boardStack.Empty() && !boardStack.Top().Board.IsSolved())
+        {
+            if (monitor && !monitor->Continue(boardStack)) { return SolveStatus::Cancelled; }
+
+            //Whatever the deductions remove stays on the board, so every guess made from it starts from there
+            if (options.Deductions != NoDeductions)
+            {
+                auto deduced = false;
+                {
+                    StatTimer timer(PropagationTime(stats));
+                    deduced = Deduce(boardStack.Top().Board, options.Deductions);
+                }
+                if (!deduced)
+                {
+                    StatTimer timer(PropagationTime(stats));
+                    Backtrack(boardStack, stats);
+                    if (observer && !boardStack.Empty()) { observer->OnBoardChanged(boardStack.Top().Board); }
+                    continue;
+                }
+                if (boardStack.Top().Board.IsSolved()) { break; }
+            }
+
+            auto& next = boardStack.PushCopy();
+            next.Guess = next.Board.MakeGuess(strategy);
+            guesses += 1;
+            if (SUDOKU_STATS && stats) { stats->MaxDepth = std::max(stats->MaxDepth, boardStack.Size()); }
+
+            auto solved = false;
+            {
+                StatTimer timer(PropagationTime(stats));
+                solved = next.Board.SolveKnown();
+            }
+            if (!solved)
+            {
+                //Clearing the guess places whatever it forces, so undoing counts as propagation too
+                StatTimer timer(PropagationTime(stats));
+                const auto guess = next.Guess;
+                boardStack.Pop();
+                if (SUDOKU_STATS && stats) { stats->Backtracks += 1; }
+                boardStack.Top().Board.ClearGuess(guess);
+                Backtrack(boardStack, stats);
+                if (observer && !boardStack.Empty()) { observer->OnBoardChanged(boardStack.Top().Board); }
+            }
+            else if (observer)
+            {
+                observer->OnBoardChanged(next.Board);
+            }
+        }
+
+        return boardStack.Empty() ? SolveStatus::Unsolvable : SolveStatus::Solved;
+    }
+
+    //Starts the stats of a solve once its stack is reset and fills in the totals however the solve ends
+    template <int BoxSize>
+    class StatsScope
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        StatsScope(SolveStats* stats, BasicMoveStack<BoxSize>& boardStack, int const& guesses)
+            : m_stats(SUDOKU_STATS ? stats : nullptr)
+            , m_boardStack(boardStack)
+            , m_guesses(guesses)
+            , m_begin(m_stats ? Clock::now() : Clock::time_point())
+        {
+            //Always set, so a pointer left on the starting board by an earlier solve is never followed
+            boardStack.Top().Board.SetStats(m_stats);
+            if (!m_stats) { return; }
+            *m_stats = SolveStats();
+            m_stats->MaxDepth = 1;
+        }
+
+        ~StatsScope()
+        {
+            if (!m_stats) { return; }
+            const auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_begin).count();
+            m_stats->Guesses = m_guesses;
+            m_stats->Copies = m_boardStack.Copies();
+            m_stats->SearchNs = std::max(0ll, (long long)total - m_stats->PropagationNs);
+        }
+
+    private:
+        SolveStats* m_stats;
+        BasicMoveStack<BoxSize>& m_boardStack;
+        int const& m_guesses;
+        Clock::time_point m_begin;
+    };
+
+    //Stops a search once its budget says so
+    template <int BoxSize>
+    class BudgetMonitor : public BasicSearchMonitor<BoxSize>
+    {
+    public:
+        BudgetMonitor(SolveBudget* budget, int const& guesses)
+            : m_budget(budget)
+            , m_guesses(guesses)
+        {
+        }
+
+        //Null when there is nothing to check, so a solve without budgets never makes the call
+        BasicSearchMonitor<BoxSize>* Monitor()
+        {
+            return m_budget != nullptr ? this : nullptr;
+        }
+
+        bool Continue(BasicMoveStack<BoxSize>&) override
+        {
+            return m_budget->Continue(m_guesses);
+        }
+
+    private:
+        SolveBudget* m_budget;
+        int const& m_guesses;
+    };
+
+    //Whether the options hand the solve to another engine rather than the masks here
+    template <int BoxSize>
+    bool UsesOtherEngine(BasicSolveOptions<BoxSize> const& options)
+    {
+        return EngineFor(options.Engine, BoxSize) != Engine::Masks;
+    }
+
+    //The board goes to the engine as a line, the way a puzzle is read from a file, and the solution comes back the same way
+    template <int BoxSize>
+    SolveStatus SolveOnEngine(Engine engine, BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int solutionLimit,
+        int& solutions, int& guesses, SolveBudget* budget)
+    {
+        char line[BasicBoard<BoxSize>::CellCount];
+        char out[BasicBoard<BoxSize>::CellCount];
+        board.ToLine(line);
+        const auto status = GetSolverEngine<BoxSize>(engine).Solve(line, out, solutionLimit, solutions, guesses, budget);
+        if (status == SolveStatus::Solved) { BasicBoard<BoxSize>::FromLine(out, solution); }
+        return status;
+    }
+
+    //Set up the board and search it
+    //Nothing is drawn unless an observer is given, so this is safe for headless use
+    template <int BoxSize>
+    SolveStatus Solve(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& guesses, BasicMoveStack<BoxSize>& boardStack,
+        BasicSolveOptions<BoxSize> const& options, BasicBoardObserver<BoxSize>* observer, SolveStats* stats)
+    {
+        boardStack.Reset(board);
+        guesses = 0;
+        StatsScope<BoxSize> scope(stats, boardStack, guesses);
+        auto budget = StartBudget(options);
+        const auto limits = budget.Limited() ? &budget : nullptr;
+
+        if (UsesOtherEngine(options))
+        {
+            auto solutions = 0;
+            const auto status = SolveOnEngine<BoxSize>(options.Engine, board, solution, 1, solutions, guesses, limits);
+            if (observer) { observer->OnSolveFinished(status == SolveStatus::Solved ? solution : board); }
+            return status;
+        }
+        if (!boardStack.Top().Board.SetInitialData())
+        {
+            if (observer) { observer->OnSolveFinished(board); }
+            return SolveStatus::InvalidInput;
+        }
+        auto solved = false;
+        {
+            StatTimer timer(PropagationTime(stats));
+            solved = boardStack.Top().Board.SolveKnown();
+        }
+        if (!solved)
+        {
+            if (observer) { observer->OnSolveFinished(board); }
+            return SolveStatus::Unsolvable;
+        }
+
+        BudgetMonitor<BoxSize> monitor(limits, guesses);
+        auto status = Search<BoxSize>(boardStack, guesses, options, observer, monitor.Monitor(), stats);
+        if (status == SolveStatus::Cancelled) { status = budget.Stopped(); }
+        if (status != SolveStatus::Solved)
+        {
+            if (observer) { observer->OnSolveFinished(board); }
+            return status;
+        }
+
+        solution = boardStack.Top().Board;
+        solution.SetStats(nullptr);
+        if (observer) { observer->OnSolveFinished(solution); }
+        return SolveStatus::Solved;
+    }
+
+    //Each solution is treated as a dead end once it is counted, so the search carries on from the last guess
+    //Nothing is drawn, this is meant for checking large numbers of puzzles
+    template <int BoxSize>
+    SolveStatus CountSolutions(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& solutions, int& guesses,
+        BasicMoveStack<BoxSize>& boardStack, BasicSolveOptions<BoxSize> const& options, SolveStats* stats)
+    {
+        auto budget = StartBudget(options);
+        return CountSolutions<BoxSize>(board, solution, solutions, guesses, boardStack, options, budget.Limited() ? &budget : nullptr, stats);
+    }
+
+    template <int BoxSize>
+    SolveStatus CountSolutions(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& solutions, int& guesses,
+        BasicMoveStack<BoxSize>& boardStack, BasicSolveOptions<BoxSize> const& options, SolveBudget* budget, SolveStats* stats)
+    {
+        boardStack.Reset(board);
+        solutions = 0;
+        guesses = 0;
+        StatsScope<BoxSize> scope(stats, boardStack, guesses);
+
+        if (UsesOtherEngine(options)) { return SolveOnEngine<BoxSize>(options.Engine, board, solution, options.SolutionLimit, solutions, guesses, budget); }
+        if (!boardStack.Top().Board.SetInitialData()) { return SolveStatus::InvalidInput; }
+        {
+            StatTimer timer(PropagationTime(stats));
+            if (!boardStack.Top().Board.SolveKnown()) { return SolveStatus::Unsolvable; }
+        }
+
+        BudgetMonitor<BoxSize> monitor(budget, guesses);
+        while (solutions < options.SolutionLimit)
+        {
+            //Guesses carry on from the last search so the budget covers the whole count
+            const auto status = Search<BoxSize>(boardStack, guesses, options, nullptr, monitor.Monitor(), stats);
+            if (status == SolveStatus::Cancelled) { return budget->Stopped(); }
+            if (status != SolveStatus::Solved) { break; }
+
+            if (solutions == 0)
+            {
+                solution = boardStack.Top().Board;
+                solution.SetStats(nullptr);
+            }
+            solutions += 1;
+
+            //A solution with no guess under it was forced, so it is the only one
+            const auto guess = boardStack.Top().Guess;
+            boardStack.Pop();
+            if (boardStack.Empty()) { break; }
+            StatTimer timer(PropagationTime(stats));
+            boardStack.Top().Board.ClearGuess(guess);
+            Backtrack(boardStack, stats);
+            if (boardStack.Empty()) { break; }
+        }
+
+        return solutions > 0 ? SolveStatus::Solved : SolveStatus::Unsolvable;
+    }
+
+    //Every box size with code compiled in
+    template class BasicBoard<3>;
+    template class BasicMoveStack<3>;
+    template SolveStatus Search<3>(BasicMoveStack<3>&, int&, BasicSolveOptions<3> const&, BasicBoardObserver<3>*, BasicSearchMonitor<3>*, SolveStats*);
+    template SolveStatus Solve<3>(BasicBoard<3> const&, BasicBoard<3>&, int&, BasicBoardObserver<3>*);
+    template SolveStatus Solve<3>(BasicBoard<3> const&, BasicBoard<3>&, int&, BasicMoveStack<3>&, BasicSolveOptions<3> const&, BasicBoardObserver<3>*, SolveStats*);
+    template SolveStatus CountSolutions<3>(BasicBoard<3> const&, BasicBoard<3>&, int&, int&, BasicMoveStack<3>&, BasicSolveOptions<3> const&, SolveStats*);
+    template SolveStatus CountSolutions<3>(BasicBoard<3> const&, BasicBoard<3>&, int&, int&, BasicMoveStack<3>&, BasicSolveOptions<3> const&, SolveBudget*, SolveStats*);
+
+    template class BasicBoard<4>;
+    template class BasicMoveStack<4>;
+    template SolveStatus Search<4>(BasicMoveStack<4>&, int&, BasicSolveOptions<4> const&, BasicBoardObserver<4>*, BasicSearchMonitor<4>*, SolveStats*);
+    template SolveStatus Solve<4>(BasicBoard<4> const&, BasicBoard<4>&, int&, BasicBoardObserver<4>*);
+    template SolveStatus Solve<4>(BasicBoard<4> const&, BasicBoard<4>&, int&, BasicMoveStack<4>&, BasicSolveOptions<4> const&, BasicBoardObserver<4>*, SolveStats*);
+    template SolveStatus CountSolutions<4>(BasicBoard<4> const&, BasicBoard<4>&, int&, int&, BasicMoveStack<4>&, BasicSolveOptions<4> const&, SolveStats*);
+    template SolveStatus CountSolutions<4>(BasicBoard<4> const&, BasicBoard<4>&, int&, int&, BasicMoveStack<4>&, BasicSolveOptions<4> const&, SolveBudget*, SolveStats*);
+
+    template class BasicBoard<5>;
+    template class BasicMoveStack<5>;
+    template SolveStatus Search<5>(BasicMoveStack<5>&, int&, BasicSolveOptions<5> const&, BasicBoardObserver<5>*, BasicSearchMonitor<5>*, SolveStats*);
+    template SolveStatus Solve<5>(BasicBoard<5> const&, BasicBoard<5>&, int&, BasicBoardObserver<5>*);
+    template SolveStatus Solve<5>(BasicBoard<5> const&, BasicBoard<5>&, int&, BasicMoveStack<5>&, BasicSolveOptions<5> const&, BasicBoardObserver<5>*, SolveStats*);
+    template SolveStatus CountSolutions<5>(BasicBoard<5> const&, BasicBoard<5>&, int&, int&, BasicMoveStack<5>&, BasicSolveOptions<5> const&, SolveStats*);
+    template SolveStatus CountSolutions<5>(BasicBoard<5> const&, BasicBoard<5>&, int&, int&, BasicMoveStack<5>&, BasicSolveOptions<5> const&, SolveBudget*, SolveStats*);
+}
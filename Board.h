@@ -1,53 +1,251 @@
-#pragma once
-#include <utility>
-
-namespace Solver
-{
-	struct Cell
-	{
-		int X;
-		int Y;
-	};
-
-	struct CellGuess : Cell
-	{
-		CellGuess(int x, int y, int v) : Cell{ x, y }, V(v) {}
-		int V;
-	};
-
-	class Board
-	{
-	public:
-		static Board GetBoard(int board);
-		Board();
-		Board(Board const& other);
-
-		void PrintBoard() const;
-		bool SolveKnown();
-		bool IsSolved() const;
-		bool IsValid() const;
-		bool SetInitialData();
-
-		CellGuess MakeGuess();
-		void ClearGuess(CellGuess const& guess);
-
-	private:
-		void SetCell(int x, int y, int v);
-		void InitCell(int x, int y, int v);
-		unsigned short GetCellMask(int x, int y) const;
-		Cell FindEmptyCell();
-
-		unsigned short GetRowMask(int y) const;
-		unsigned short GetColMask(int x) const;
-		unsigned short GetBoxMask(int bx, int by) const;
-
-		char m_board[9][9];
-		unsigned short m_rowMask[9];
-		unsigned short m_colMask[9];
-		unsigned short m_boxMask[3][3];
-		unsigned short m_cellMask[9][9];
-		char m_lastEmptyRow;
-	};
-
-	void SolveBoard(Board const& board);
+#pragma once
+#include <chrono>
+#include <utility>
+#include <string>
+#include <memory>
+
+#include "Bits.h"
+#include "BoardObserver.h"
+#include "Branching.h"
+#include "Deductions.h"
+#include "Engine.h"
+#include "SolveStats.h"
+
+namespace Solver
+{
+	struct Cell
+	{
+		int X;
+		int Y;
+	};
+
+	struct CellGuess : Cell
+	{
+		CellGuess() : Cell{ 0, 0 }, V(0) {}
+		CellGuess(int x, int y, int v) : Cell{ x, y }, V(v) {}
+		int V;
+	};
+
+	//A grid of BoxSize x BoxSize boxes, so 3 is the classic 9x9 and 4 and 5 are 16x16 and 25x25
+	//Every size gets its own code with the sizes and mask widths known at compile time
+	//Code is compiled in for box sizes 3, 4 and 5
+	template <int BoxSize>
+	class BasicBoard
+	{
+	public:
+		static const int Size = BoxSize * BoxSize;
+		static const int CellCount = Size * Size;
+		static const int UnitCount = 3 * Size;
+		static const int PeerCount = 2 * (Size - 1) + (BoxSize - 1) * (BoxSize - 1);
+		//Words in the set of empty cells
+		static const int EmptyWords = (CellCount + 63) / 64;
+		static_assert(Size + 2 <= 64, "Place masks need two bits past the cells of a unit");
+
+		//Candidates of a cell, bit v - 1 is set for value v
+		using Mask = MaskFor<Size>;
+		//Positions within a unit, with room for the marker of a placed digit
+		using PlaceMask = MaskFor<Size + 2>;
+		using CellIndex = typename std::conditional<(CellCount <= 256), unsigned char, unsigned short>::type;
+
+		static bool FromLine(std::string const& line, BasicBoard& board);
+		//Reads exactly CellCount characters, so line must have at least that many
+		static bool FromLine(const char* line, BasicBoard& board);
+		BasicBoard();
+		BasicBoard(BasicBoard const& other);
+		BasicBoard& operator=(BasicBoard const& other);
+
+		void ToLine(char* line) const;
+		int GetCell(int x, int y) const;
+		bool SolveKnown();
+		bool IsSolved() const;
+		bool IsValid() const;
+		bool SetInitialData();
+
+		//Candidates of a cell as a mask with bit v - 1 set for value v, zero once the cell is filled
+		Mask GetCandidates(int cell) const;
+		//Cells that can still hold v in a unit as a mask of positions within the unit, zero once v is placed there
+		Mask GetPlaces(int unit, int v) const;
+		//The PeerCount cells sharing a row, column or box with the cell
+		static CellIndex const* GetPeers(int cell);
+		//The Size cells of a unit, in the order GetPlaces numbers them
+		static CellIndex const* GetUnitCells(int unit);
+		//The first empty cell in row order, or -1, -1 once the board is full
+		Cell FindEmptyCell() const;
+		//Word i of the set of empty cells, bit j is set while cell i * 64 + j is empty
+		uint64_t GetEmptyCells(int word) const;
+
+		CellGuess MakeGuess(BasicBranchStrategy<BoxSize> const& strategy);
+		void ClearGuess(CellGuess const& guess);
+		//Take a candidate out of a cell, anything it forces is left for SolveKnown
+		void RemoveCandidate(int cell, int v);
+		//Count the singles SolveKnown places into stats, copies of the board count into the same place
+		void SetStats(SolveStats* stats);
+
+	private:
+		//A cell that can only hold one value, waiting to be placed by SolveKnown
+		struct Single
+		{
+			CellIndex Cell;
+			unsigned char Value;
+		};
+
+		void SetCell(int x, int y, int v);
+		void InitCell(int x, int y, int v);
+		void PlaceCell(int cell, int v);
+		void Eliminate(int cell, int v);
+		void RemovePlace(int cell, int v);
+		void Enqueue(int cell, int v);
+
+		//Cells are stored in row order, units are rows, then columns, then boxes
+		char m_board[CellCount];
+		Mask m_unitMask[UnitCount];
+		Mask m_cellMask[CellCount];
+		//Which cells of each unit can still hold each digit, so a hidden single is found the moment it appears
+		PlaceMask m_digitPlaces[UnitCount][Size];
+		//Each cell can become a naked single once and each unit/digit a hidden single once, so this never overflows
+		Single m_queue[CellCount + UnitCount * Size];
+		//Kept as cells are placed so a full board or the first empty cell is found from a few words
+		uint64_t m_empty[EmptyWords];
+		short m_queueSize;
+		bool m_valid;
+#if SUDOKU_STATS
+		SolveStats* m_stats;
+#endif
+	};
+
+	//Values are written 1-9, then A-Z for the larger grids, CharValue returns 0 for anything else
+	char ValueChar(int v);
+	int CharValue(char c);
+
+	//Board itself is the 9x9 one, declared with the observer
+	using Board16 = BasicBoard<4>;
+	using Board25 = BasicBoard<5>;
+
+	enum class SolveStatus
+	{
+		Solved,
+		Unsolvable,
+		InvalidInput,
+		Cancelled,
+		//Ran out of the guesses or time the options allow before an answer
+		BudgetExceeded
+	};
+
+	template <int BoxSize>
+	class BasicSolutionCache;
+
+	//Settings for one solve, the defaults suit most puzzles
+	template <int BoxSize>
+	struct BasicSolveOptions
+	{
+		BasicBranchStrategy<BoxSize> const* Strategy = &GetBranchStrategy<BoxSize>(Branching::MinimumRemaining);
+		//Deduction flags tried before each guess
+		unsigned int Deductions = DefaultDeductions;
+		//Solutions to find before stopping, Solve always stops at the first
+		//CountSolutions and batch mode look for more when this is above 1, 2 is enough to tell a unique puzzle apart
+		int SolutionLimit = 1;
+		//Strategy and Deductions only apply to Masks, which also solves any size the engine has no code for
+		Solver::Engine Engine = Solver::Engine::Masks;
+		//Batch mode looks puzzles that need a search up here first and stores what it solves, none by default
+		BasicSolutionCache<BoxSize>* Cache = nullptr;
+		//Budgets for each solve, checked before every guess. A solve that runs out stops with BudgetExceeded and keeps
+		//the stats it gathered. Guesses and milliseconds are counted per solve, 0 for no limit, and the deadline is
+		//a point in time shared by every solve given it. Every engine checks them, each counting guesses its own way
+		int GuessLimit = 0;
+		int TimeLimitMs = 0;
+		std::chrono::steady_clock::time_point Deadline = std::chrono::steady_clock::time_point::max();
+		//Stops a solve with Cancelled once it is cancelled, from any thread
+		CancelToken const* Cancel = nullptr;
+	};
+
+	//The budget a solve with these options starts with
+	template <int BoxSize>
+	SolveBudget StartBudget(BasicSolveOptions<BoxSize> const& options)
+	{
+		return SolveBudget(options.GuessLimit, options.TimeLimitMs, options.Deadline, options.Cancel);
+	}
+
+	using SolveOptions = BasicSolveOptions<3>;
+
+	template <int BoxSize>
+	struct BasicMove
+	{
+		BasicBoard<BoxSize> Board;
+		CellGuess Guess;
+	};
+
+	using Move = BasicMove<3>;
+
+	//Boards saved at each guess, in slots allocated once up front
+	//Every guess fills an empty cell, so there are never more levels above the starting board than cells
+	//Hold on to one between solves and solving never touches the heap
+	template <int BoxSize>
+	class BasicMoveStack
+	{
+	public:
+		static const int Capacity = BasicBoard<BoxSize>::CellCount + 1;
+
+		BasicMoveStack();
+
+		//Start over with just the given board at the bottom
+		void Reset(BasicBoard<BoxSize> const& board);
+
+		bool Empty() const;
+		int Size() const;
+		BasicMove<BoxSize>& Top();
+		//Levels are counted from the bottom
+		BasicMove<BoxSize>& operator[](int level);
+
+		//Copy the top board into the next slot and return it, the copy is where the next guess goes
+		BasicMove<BoxSize>& PushCopy();
+		void Pop();
+		//Forget the bottom board, used to hand its untried guesses to someone else
+		void DropBottom();
+
+		//Boards copied since the last Reset, including the starting board
+		long long Copies() const;
+
+	private:
+		std::unique_ptr<BasicMove<BoxSize>[]> m_moves;
+		int m_bottom;
+		int m_top;
+		long long m_copies;
+	};
+
+	using MoveStack = BasicMoveStack<3>;
+
+	//Lets a caller step in before every guess, the search runs without one
+	template <int BoxSize>
+	class BasicSearchMonitor
+	{
+	public:
+		virtual ~BasicSearchMonitor() = default;
+
+		//Return false to stop the search, the stack may be trimmed from the bottom to give work away
+		virtual bool Continue(BasicMoveStack<BoxSize>& boardStack) = 0;
+	};
+
+	using SearchMonitor = BasicSearchMonitor<3>;
+
+	//Every solve can fill in a SolveStats, leave it null to skip the counting
+	template <int BoxSize>
+	SolveStatus Search(BasicMoveStack<BoxSize>& boardStack, int& guesses, BasicSolveOptions<BoxSize> const& options,
+		BasicBoardObserver<BoxSize>* observer, BasicSearchMonitor<BoxSize>* monitor, SolveStats* stats = nullptr);
+	template <int BoxSize>
+	SolveStatus Solve(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& guesses, BasicBoardObserver<BoxSize>* observer = nullptr);
+	template <int BoxSize>
+	SolveStatus Solve(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& guesses, BasicMoveStack<BoxSize>& boardStack,
+		BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>(), BasicBoardObserver<BoxSize>* observer = nullptr,
+		SolveStats* stats = nullptr);
+	//Keep searching past the first solution until options.SolutionLimit are found or there are no more
+	//solutions is the number found, capped at the limit, and solution is the first one
+	//A count stopped by a budget or cancelled keeps the solutions found before it stopped
+	template <int BoxSize>
+	SolveStatus CountSolutions(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& solutions, int& guesses,
+		BasicMoveStack<BoxSize>& boardStack, BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>(),
+		SolveStats* stats = nullptr);
+	//The same with a budget the caller started, which is checked in place of the limits in the options, null for none
+	template <int BoxSize>
+	SolveStatus CountSolutions(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& solutions, int& guesses,
+		BasicMoveStack<BoxSize>& boardStack, BasicSolveOptions<BoxSize> const& options, SolveBudget* budget, SolveStats* stats = nullptr);
 }
\ No newline at end of file
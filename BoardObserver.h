@@ -0,0 +1,25 @@
+#pragma once
+
+namespace Solver
+{
+	template <int BoxSize>
+	class BasicBoard;
+	//The classic 9x9 board, see Board.h
+	using Board = BasicBoard<3>;
+
+	//Receives the board as the solver works on it
+	//Solve only calls into an observer when one is given, so headless solving pays nothing for it
+	template <int BoxSize>
+	class BasicBoardObserver
+	{
+	public:
+		virtual ~BasicBoardObserver() = default;
+
+		//Called after every guess and every backtrack
+		virtual void OnBoardChanged(BasicBoard<BoxSize> const& board) = 0;
+		//Called once with the solution, or the starting board if there isn't one
+		virtual void OnSolveFinished(BasicBoard<BoxSize> const& board) = 0;
+	};
+
+	using BoardObserver = BasicBoardObserver<3>;
+}
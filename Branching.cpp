@@ -0,0 +1,171 @@
+#include <string.h>
+
+#include "Bits.h"
+#include "Board.h"
+#include "Branching.h"
+
+namespace Solver
+{
+    //Empty cells have at least two candidates once SolveKnown is done, so stop looking as soon as one has two
+    //Only the empty cells are visited, in row order
+    template <int BoxSize>
+    int FewestCandidates(BasicBoard<BoxSize> const& board)
+    {
+        auto best = -1;
+        auto bestCount = BasicBoard<BoxSize>::Size + 1;
+        for (auto word = 0; word < BasicBoard<BoxSize>::EmptyWords; ++word)
+        {
+            for (auto empty = board.GetEmptyCells(word); empty != 0; empty &= empty - 1)
+            {
+                const auto cell = word * 64 + (int)LowestBit(empty);
+                const auto count = CountBits(board.GetCandidates(cell));
+                if (count < bestCount)
+                {
+                    best = cell;
+                    bestCount = count;
+                    if (count <= 2) { return best; }
+                }
+            }
+        }
+        return best;
+    }
+
+    template <int BoxSize>
+    CellGuess LowestValue(BasicBoard<BoxSize> const& board, int cell)
+    {
+        const auto size = BasicBoard<BoxSize>::Size;
+        return CellGuess(cell % size, cell / size, (int)LowestBit(board.GetCandidates(cell)) + 1);
+    }
+
+    template <int BoxSize>
+    class FirstEmptyStrategy : public BasicBranchStrategy<BoxSize>
+    {
+    public:
+        CellGuess Choose(BasicBoard<BoxSize> const& board) const override
+        {
+            const auto cell = board.FindEmptyCell();
+            return LowestValue(board, cell.Y * BasicBoard<BoxSize>::Size + cell.X);
+        }
+    };
+
+    template <int BoxSize>
+    class MinimumRemainingStrategy : public BasicBranchStrategy<BoxSize>
+    {
+    public:
+        CellGuess Choose(BasicBoard<BoxSize> const& board) const override
+        {
+            return LowestValue(board, FewestCandidates(board));
+        }
+    };
+
+    //Empty peers are the cells a guess here constrains, so the most constrained of the tied cells is guessed first
+    template <int BoxSize>
+    class MinimumRemainingDegreeStrategy : public BasicBranchStrategy<BoxSize>
+    {
+    public:
+        CellGuess Choose(BasicBoard<BoxSize> const& board) const override
+        {
+            auto best = -1;
+            auto bestCount = BasicBoard<BoxSize>::Size + 1;
+            auto bestDegree = -1;
+            for (auto word = 0; word < BasicBoard<BoxSize>::EmptyWords; ++word)
+            {
+                for (auto empty = board.GetEmptyCells(word); empty != 0; empty &= empty - 1)
+                {
+                    const auto cell = word * 64 + (int)LowestBit(empty);
+                    const auto count = CountBits(board.GetCandidates(cell));
+                    if (count > bestCount) { continue; }
+
+                    //Degree is only worth working out for cells that tie or beat the best so far
+                    const auto degree = Degree(board, cell);
+                    if (count < bestCount || degree > bestDegree)
+                    {
+                        best = cell;
+                        bestCount = count;
+                        bestDegree = degree;
+                    }
+                }
+            }
+            return LowestValue(board, best);
+        }
+
+    private:
+        static int Degree(BasicBoard<BoxSize> const& board, int cell)
+        {
+            auto const* peers = BasicBoard<BoxSize>::GetPeers(cell);
+            auto degree = 0;
+            for (auto i = 0; i < BasicBoard<BoxSize>::PeerCount; ++i)
+            {
+                if (board.GetCandidates(peers[i]) != 0) { ++degree; }
+            }
+            return degree;
+        }
+    };
+
+    //Values that leave the peers the most room are the most likely to be right
+    template <int BoxSize>
+    class LeastConstrainingStrategy : public BasicBranchStrategy<BoxSize>
+    {
+    public:
+        CellGuess Choose(BasicBoard<BoxSize> const& board) const override
+        {
+            using Mask = typename BasicBoard<BoxSize>::Mask;
+            const auto cell = FewestCandidates(board);
+            auto const* peers = BasicBoard<BoxSize>::GetPeers(cell);
+
+            auto best = 0;
+            auto bestCost = BasicBoard<BoxSize>::PeerCount + 1;
+            for (auto bits = board.GetCandidates(cell); bits != 0; bits &= bits - 1)
+            {
+                const auto bit = (Mask)(bits & (0u - bits));
+                auto cost = 0;
+                for (auto i = 0; i < BasicBoard<BoxSize>::PeerCount; ++i)
+                {
+                    if (board.GetCandidates(peers[i]) & bit) { ++cost; }
+                }
+                if (cost < bestCost)
+                {
+                    best = (int)LowestBit(bits) + 1;
+                    bestCost = cost;
+                }
+            }
+            const auto size = BasicBoard<BoxSize>::Size;
+            return CellGuess(cell % size, cell / size, best);
+        }
+    };
+
+    template <int BoxSize>
+    BasicBranchStrategy<BoxSize> const& GetBranchStrategy(Branching branching)
+    {
+        static const FirstEmptyStrategy<BoxSize> firstEmpty{};
+        static const MinimumRemainingStrategy<BoxSize> minimumRemaining{};
+        static const MinimumRemainingDegreeStrategy<BoxSize> minimumRemainingDegree{};
+        static const LeastConstrainingStrategy<BoxSize> leastConstraining{};
+
+        switch (branching)
+        {
+        case Branching::FirstEmpty:
+            return firstEmpty;
+        case Branching::MinimumRemainingDegree:
+            return minimumRemainingDegree;
+        case Branching::LeastConstraining:
+            return leastConstraining;
+        default:
+            return minimumRemaining;
+        }
+    }
+
+    bool ParseBranching(const char* name, Branching& branching)
+    {
+        if (strcmp(name, "first") == 0) { branching = Branching::FirstEmpty; }
+        else if (strcmp(name, "mrv") == 0) { branching = Branching::MinimumRemaining; }
+        else if (strcmp(name, "degree") == 0) { branching = Branching::MinimumRemainingDegree; }
+        else if (strcmp(name, "lcv") == 0) { branching = Branching::LeastConstraining; }
+        else { return false; }
+        return true;
+    }
+
+    template BasicBranchStrategy<3> const& GetBranchStrategy<3>(Branching branching);
+    template BasicBranchStrategy<4> const& GetBranchStrategy<4>(Branching branching);
+    template BasicBranchStrategy<5> const& GetBranchStrategy<5>(Branching branching);
+}
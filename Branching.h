@@ -0,0 +1,40 @@
+#pragma once
+
+namespace Solver
+{
+	template <int BoxSize>
+	class BasicBoard;
+	struct CellGuess;
+
+	//Picks the cell to guess next and the value to try in it
+	//A failed guess is cleared from the board and the strategy is asked again, so the value order falls out of picking the best value left
+	//Strategies hold no state, so one can be shared by every thread
+	template <int BoxSize>
+	class BasicBranchStrategy
+	{
+	public:
+		virtual ~BasicBranchStrategy() = default;
+
+		//Only called on a valid board that still has an empty cell
+		virtual CellGuess Choose(BasicBoard<BoxSize> const& board) const = 0;
+	};
+
+	using BranchStrategy = BasicBranchStrategy<3>;
+
+	enum class Branching
+	{
+		//First empty cell in row order, lowest value first
+		FirstEmpty,
+		//Cell with the fewest candidates
+		MinimumRemaining,
+		//Fewest candidates, ties go to the cell with the most empty peers
+		MinimumRemainingDegree,
+		//Fewest candidates, trying the value that removes the fewest peer candidates first
+		LeastConstraining
+	};
+
+	template <int BoxSize = 3>
+	BasicBranchStrategy<BoxSize> const& GetBranchStrategy(Branching branching);
+	//Names are first, mrv, degree and lcv
+	bool ParseBranching(const char* name, Branching& branching);
+}
@@ -0,0 +1,378 @@
+#include "Canonical.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+namespace Solver
+{
+    //Transforms left tied at once before a puzzle counts as too symmetric to be worth canonicalizing
+    const size_t MaxCanonicalTransforms = 4096;
+    //Blanks compare above every label
+    const unsigned char CanonicalBlank = 0xFF;
+
+    //Insertion sort for the handful of items in a stack, where std::sort costs more than the sorting
+    template <typename T, typename Less>
+    void SortSmall(T* items, int count, Less less)
+    {
+        for (auto i = 1; i < count; ++i)
+        {
+            const auto item = items[i];
+            auto j = i;
+            for (; j > 0 && less(item, items[j - 1]); --j) { items[j] = items[j - 1]; }
+            items[j] = item;
+        }
+    }
+
+    template <int BoxSize>
+    void ApplyTransform(BasicGridTransform<BoxSize> const& transform, const char* in, char* out)
+    {
+        const auto size = BasicGridTransform<BoxSize>::Size;
+        for (auto r = 0; r < size; ++r)
+        {
+            for (auto c = 0; c < size; ++c)
+            {
+                const int row = transform.Rows[r];
+                const int column = transform.Columns[c];
+                const auto v = CharValue(in[transform.Transposed ? column * size + row : row * size + column]);
+                const auto label = v <= size ? transform.Labels[v] : 0;
+                out[r * size + c] = label ? ValueChar(label) : '.';
+            }
+        }
+    }
+
+    template <int BoxSize>
+    void InvertTransform(BasicGridTransform<BoxSize> const& transform, const char* in, char* out)
+    {
+        const auto size = BasicGridTransform<BoxSize>::Size;
+        unsigned char values[size + 1] = {};
+        for (auto v = 1; v <= size; ++v) { values[transform.Labels[v]] = (unsigned char)v; }
+        values[0] = 0;
+
+        for (auto r = 0; r < size; ++r)
+        {
+            for (auto c = 0; c < size; ++c)
+            {
+                const int row = transform.Rows[r];
+                const int column = transform.Columns[c];
+                const auto label = CharValue(in[r * size + c]);
+                const auto v = label <= size ? values[label] : 0;
+                out[transform.Transposed ? column * size + row : row * size + column] = v ? ValueChar(v) : '.';
+            }
+        }
+    }
+
+    //A transform being built, with the rows placed so far and the values labeled so far
+    //The columns of each stack that are blank in every row placed so far are still interchangeable, they sit at the
+    //end of the stack in any order and only get an order of their own once a row puts values in them
+    template <int BoxSize>
+    struct CanonicalCandidate
+    {
+        BasicGridTransform<BoxSize> Transform;
+        int NextLabel;
+        uint32_t UsedRows;
+        //Columns at the start of each stack that are still loose
+        unsigned char Loose[BoxSize];
+    };
+
+    //The working space of Canonicalize, kept per thread so the candidate lists are only allocated once
+    template <int BoxSize>
+    class Canonicalizer
+    {
+    public:
+        static const int Size = BoxSize * BoxSize;
+        using Candidate = CanonicalCandidate<BoxSize>;
+
+        bool Run(const char* puzzle, char* canonical, BasicGridTransform<BoxSize>& transform);
+
+    private:
+        bool ReadPuzzle(const char* puzzle);
+        bool Start();
+        bool NextRow(int level);
+        bool TryRow(Candidate const& candidate, int level, int row);
+        bool AddArrangements(Candidate const& candidate, int level, int row, unsigned char* columns, unsigned char const* loose,
+            int const* newStart, int const* newCount);
+
+        //The puzzle and its transpose, blanks are 0
+        unsigned char m_grids[2][Size][Size];
+        std::vector<Candidate> m_current;
+        std::vector<Candidate> m_next;
+        //The largest row of the level so far
+        unsigned char m_best[Size];
+        bool m_found;
+    };
+
+    //Givens that clash are left for the solver to report
+    template <int BoxSize>
+    bool Canonicalizer<BoxSize>::ReadPuzzle(const char* puzzle)
+    {
+        uint32_t rows[Size] = {};
+        uint32_t columns[Size] = {};
+        uint32_t boxes[Size] = {};
+        for (auto r = 0; r < Size; ++r)
+        {
+            for (auto c = 0; c < Size; ++c)
+            {
+                const auto ch = puzzle[r * Size + c];
+                const auto v = CharValue(ch);
+                auto& cell = m_grids[0][r][c];
+                cell = 0;
+                if (v >= 1 && v <= Size)
+                {
+                    const auto bit = 1u << v;
+                    auto& box = boxes[(r / BoxSize) * BoxSize + c / BoxSize];
+                    if ((rows[r] | columns[c] | box) & bit) { return false; }
+                    rows[r] |= bit;
+                    columns[c] |= bit;
+                    box |= bit;
+                    cell = (unsigned char)v;
+                }
+                else if (ch != '.' && ch != '0') { return false; }
+                m_grids[1][c][r] = cell;
+            }
+        }
+        return true;
+    }
+
+    //The first row's string only depends on how many values each stack of it holds, so only the rows whose counts
+    //sort the smallest start a candidate, with the stacks that hold fewer going first
+    template <int BoxSize>
+    bool Canonicalizer<BoxSize>::Start()
+    {
+        int counts[2][Size][BoxSize];
+        int sorted[2][Size][BoxSize];
+        int best[BoxSize];
+        std::fill(best, best + BoxSize, BoxSize + 1);
+        for (auto t = 0; t < 2; ++t)
+        {
+            for (auto r = 0; r < Size; ++r)
+            {
+                for (auto s = 0; s < BoxSize; ++s)
+                {
+                    counts[t][r][s] = 0;
+                    for (auto k = 0; k < BoxSize; ++k) { counts[t][r][s] += m_grids[t][r][s * BoxSize + k] != 0; }
+                    sorted[t][r][s] = counts[t][r][s];
+                }
+                SortSmall(sorted[t][r], BoxSize, [](int a, int b) { return a < b; });
+                if (std::lexicographical_compare(sorted[t][r], sorted[t][r] + BoxSize, best, best + BoxSize))
+                {
+                    std::copy(sorted[t][r], sorted[t][r] + BoxSize, best);
+                }
+            }
+        }
+
+        m_found = false;
+        m_next.clear();
+        for (auto t = 0; t < 2; ++t)
+        {
+            for (auto r = 0; r < Size; ++r)
+            {
+                if (!std::equal(best, best + BoxSize, sorted[t][r])) { continue; }
+                unsigned char stacks[BoxSize];
+                for (auto s = 0; s < BoxSize; ++s) { stacks[s] = (unsigned char)s; }
+                do
+                {
+                    auto ascending = true;
+                    for (auto p = 1; p < BoxSize; ++p) { ascending = ascending && counts[t][r][stacks[p - 1]] <= counts[t][r][stacks[p]]; }
+                    if (!ascending) { continue; }
+
+                    auto candidate = Candidate();
+                    candidate.Transform.Transposed = t != 0;
+                    for (auto p = 0; p < BoxSize; ++p)
+                    {
+                        for (auto k = 0; k < BoxSize; ++k) { candidate.Transform.Columns[p * BoxSize + k] = (unsigned char)(stacks[p] * BoxSize + k); }
+                    }
+                    std::fill(candidate.Loose, candidate.Loose + BoxSize, (unsigned char)BoxSize);
+                    candidate.NextLabel = 1;
+                    if (!TryRow(candidate, 0, r)) { return false; }
+                } while (std::next_permutation(stacks, stacks + BoxSize));
+            }
+        }
+        m_current.swap(m_next);
+        return true;
+    }
+
+    //Each candidate tries every row that can go next, the rest of its band or the first row of a band not used yet
+    template <int BoxSize>
+    bool Canonicalizer<BoxSize>::NextRow(int level)
+    {
+        m_found = false;
+        m_next.clear();
+        for (auto const& candidate : m_current)
+        {
+            const auto band = level % BoxSize == 0 ? -1 : candidate.Transform.Rows[level - 1] / BoxSize;
+            for (auto r = 0; r < Size; ++r)
+            {
+                if ((candidate.UsedRows >> r) & 1) { continue; }
+                if (band >= 0 && r / BoxSize != band) { continue; }
+                if (!TryRow(candidate, level, r)) { return false; }
+            }
+        }
+        m_current.swap(m_next);
+        return true;
+    }
+
+    //Keeps the candidate with the row placed next when that gives the largest row so far, a larger one drops the rest
+    //Loose columns take the row's new values first, since those get the next labels, then the labeled values from
+    //the largest label down, then the blanks, which stay loose. The row is given up on at the first cell below the best.
+    template <int BoxSize>
+    bool Canonicalizer<BoxSize>::TryRow(Candidate const& candidate, int level, int row)
+    {
+        auto const& transform = candidate.Transform;
+        auto const& cells = m_grids[transform.Transposed ? 1 : 0][row];
+        unsigned char labels[Size + 1];
+        std::copy(transform.Labels, transform.Labels + Size + 1, labels);
+        auto nextLabel = candidate.NextLabel;
+        unsigned char columns[Size];
+        std::copy(transform.Columns, transform.Columns + Size, columns);
+        unsigned char loose[BoxSize];
+        int newStart[BoxSize];
+        int newCount[BoxSize];
+        unsigned char line[Size];
+
+        //Above 0 once the row is larger than the best, so the rest needn't be compared
+        auto order = m_found ? 0 : 1;
+        auto below = [&](int i) {
+            if (order == 0 && line[i] != m_best[i]) { order = line[i] > m_best[i] ? 1 : -1; }
+            return order < 0;
+        };
+
+        for (auto p = 0; p < BoxSize; ++p)
+        {
+            const auto first = p * BoxSize;
+            const auto settled = first + candidate.Loose[p];
+            unsigned char labeled[BoxSize];
+            unsigned char fresh[BoxSize];
+            auto labeledCount = 0;
+            auto freshCount = 0;
+            auto position = first;
+            for (auto i = first; i < settled; ++i)
+            {
+                const auto column = transform.Columns[i];
+                const auto v = cells[column];
+                if (!v)
+                {
+                    columns[position] = column;
+                    line[position] = CanonicalBlank;
+                    if (below(position++)) { return true; }
+                }
+                else if (labels[v]) { labeled[labeledCount++] = column; }
+                else { fresh[freshCount++] = column; }
+            }
+            loose[p] = (unsigned char)(position - first);
+            newStart[p] = position;
+            newCount[p] = freshCount;
+            SortSmall(fresh, freshCount, [](unsigned char a, unsigned char b) { return a < b; });
+            for (auto i = 0; i < freshCount; ++i, ++position)
+            {
+                columns[position] = fresh[i];
+                labels[cells[fresh[i]]] = (unsigned char)nextLabel;
+                line[position] = (unsigned char)nextLabel++;
+                if (below(position)) { return true; }
+            }
+            SortSmall(labeled, labeledCount, [&](unsigned char a, unsigned char b) { return labels[cells[a]] > labels[cells[b]]; });
+            for (auto i = 0; i < labeledCount; ++i, ++position)
+            {
+                columns[position] = labeled[i];
+                line[position] = labels[cells[labeled[i]]];
+                if (below(position)) { return true; }
+            }
+
+            for (auto i = settled; i < first + BoxSize; ++i)
+            {
+                const auto v = cells[columns[i]];
+                if (v && !labels[v]) { labels[v] = (unsigned char)nextLabel++; }
+                line[i] = v ? labels[v] : CanonicalBlank;
+                if (below(i)) { return true; }
+            }
+        }
+
+        if (order > 0)
+        {
+            m_next.clear();
+            std::copy(line, line + Size, m_best);
+            m_found = true;
+        }
+        return AddArrangements(candidate, level, row, columns, loose, newStart, newCount);
+    }
+
+    //New values that share the loose columns of a stack give the same row in any order, but label the values
+    //differently for the rows after, so every order is kept
+    template <int BoxSize>
+    bool Canonicalizer<BoxSize>::AddArrangements(Candidate const& candidate, int level, int row, unsigned char* columns,
+        unsigned char const* loose, int const* newStart, int const* newCount)
+    {
+        auto const& cells = m_grids[candidate.Transform.Transposed ? 1 : 0][row];
+        for (;;)
+        {
+            if (m_next.size() >= MaxCanonicalTransforms) { return false; }
+            m_next.push_back(candidate);
+            auto& next = m_next.back();
+            auto& transform = next.Transform;
+            transform.Rows[level] = (unsigned char)row;
+            std::copy(columns, columns + Size, transform.Columns);
+            std::copy(loose, loose + BoxSize, next.Loose);
+            for (auto c = 0; c < Size; ++c)
+            {
+                const auto v = cells[columns[c]];
+                if (v && !transform.Labels[v]) { transform.Labels[v] = (unsigned char)next.NextLabel++; }
+            }
+            next.UsedRows |= 1u << row;
+
+            //Step to the next order like counting, each stack's new columns being a digit
+            auto p = 0;
+            while (p < BoxSize && !std::next_permutation(columns + newStart[p], columns + newStart[p] + newCount[p])) { ++p; }
+            if (p == BoxSize) { return true; }
+        }
+    }
+
+    template <int BoxSize>
+    bool Canonicalizer<BoxSize>::Run(const char* puzzle, char* canonical, BasicGridTransform<BoxSize>& transform)
+    {
+        if (!ReadPuzzle(puzzle)) { return false; }
+        if (!Start()) { return false; }
+        for (auto level = 1; level < Size; ++level)
+        {
+            if (!NextRow(level)) { return false; }
+        }
+
+        //Any that are left give the same string, values missing from the puzzle take the labels left over in order
+        auto const& chosen = m_current.front();
+        transform = chosen.Transform;
+        auto nextLabel = chosen.NextLabel;
+        for (auto v = 1; v <= Size; ++v)
+        {
+            if (!transform.Labels[v]) { transform.Labels[v] = (unsigned char)nextLabel++; }
+        }
+        transform.Labels[0] = 0;
+
+        auto const& grid = m_grids[transform.Transposed ? 1 : 0];
+        for (auto r = 0; r < Size; ++r)
+        {
+            for (auto c = 0; c < Size; ++c)
+            {
+                const auto v = grid[transform.Rows[r]][transform.Columns[c]];
+                canonical[r * Size + c] = v ? ValueChar(transform.Labels[v]) : '.';
+            }
+        }
+        return true;
+    }
+
+    template <int BoxSize>
+    bool Canonicalize(const char* puzzle, char* canonical, BasicGridTransform<BoxSize>& transform)
+    {
+        static thread_local Canonicalizer<BoxSize> canonicalizer;
+        return canonicalizer.Run(puzzle, canonical, transform);
+    }
+
+    template void ApplyTransform<3>(BasicGridTransform<3> const&, const char*, char*);
+    template void InvertTransform<3>(BasicGridTransform<3> const&, const char*, char*);
+    template bool Canonicalize<3>(const char*, char*, BasicGridTransform<3>&);
+    template void ApplyTransform<4>(BasicGridTransform<4> const&, const char*, char*);
+    template void InvertTransform<4>(BasicGridTransform<4> const&, const char*, char*);
+    template bool Canonicalize<4>(const char*, char*, BasicGridTransform<4>&);
+    template void ApplyTransform<5>(BasicGridTransform<5> const&, const char*, char*);
+    template void InvertTransform<5>(BasicGridTransform<5> const&, const char*, char*);
+    template bool Canonicalize<5>(const char*, char*, BasicGridTransform<5>&);
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Board.h"
+
+namespace Solver
+{
+	//A rearrangement of the grid that keeps a puzzle a puzzle, with the same number of solutions
+	//Cell (r, c) of the result is cell (Rows[r], Columns[c]) of the grid, or of its transpose,
+	//with the value v there written as Labels[v]. Rows only move within their band and bands as a whole,
+	//likewise columns within their stack, so every unit stays a unit.
+	template <int BoxSize>
+	struct BasicGridTransform
+	{
+		static const int Size = BasicBoard<BoxSize>::Size;
+
+		bool Transposed;
+		unsigned char Rows[Size];
+		unsigned char Columns[Size];
+		//Indexed by value, 0 is a blank and stays one
+		unsigned char Labels[Size + 1];
+	};
+
+	using GridTransform = BasicGridTransform<3>;
+
+	//Both take and write CellCount characters, blanks are written as '.'
+	template <int BoxSize>
+	void ApplyTransform(BasicGridTransform<BoxSize> const& transform, const char* in, char* out);
+	//Takes a transformed grid back to where it came from, used to map a solution of the canonical form onto the puzzle
+	template <int BoxSize>
+	void InvertTransform(BasicGridTransform<BoxSize> const& transform, const char* in, char* out);
+
+	//The canonical form of a puzzle is the largest string any transform makes of it, reading blanks as larger than any
+	//value and labeling values 1, 2, 3... in the order they first appear. Puzzles that differ by relabeling, moving rows
+	//within bands, columns within stacks, bands, stacks or by transposing have the same one.
+	//Blanks coming first puts the sparsest rows on top, where few values means few ways to label them.
+	//Rows are fixed one at a time, keeping every transform that ties for the largest so far, which is quick when
+	//the givens break the ties early. Returns false for a character that isn't a value or a blank, for givens that
+	//clash and for a puzzle so symmetric that too many transforms stay tied, all of which the caller should just solve.
+	template <int BoxSize>
+	bool Canonicalize(const char* puzzle, char* canonical, BasicGridTransform<BoxSize>& transform);
+}
@@ -0,0 +1,277 @@
+#include "DancingLinks.h"
+
+#include <vector>
+
+namespace Solver
+{
+    //The exact cover matrix of one grid size, every link an index into one arena of nodes
+    //Node 0 is the root, then a header for each column, then four nodes for each row in row order
+    template <int BoxSize>
+    class DancingLinks
+    {
+    public:
+        static const int Size = BasicBoard<BoxSize>::Size;
+        static const int CellCount = BasicBoard<BoxSize>::CellCount;
+        static const int Columns = 4 * CellCount;
+        static const int Rows = CellCount * Size;
+        static const int FirstRowNode = 1 + Columns;
+
+        DancingLinks();
+
+        SolveStatus Solve(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses, SolveBudget* budget);
+
+    private:
+        struct Node
+        {
+            int Left;
+            int Right;
+            int Up;
+            int Down;
+            //The header of the node's column, a header is its own
+            int Column;
+        };
+
+        void Cover(int column);
+        void Uncover(int column);
+        //Covers the columns of every node in the row, the order Deselect undoes it in reverse
+        void Select(int node);
+        void Deselect(int node);
+        //Returns true once there are enough solutions to stop, or the budget ran out
+        bool Search(int depth);
+        void WriteSolution(int picked);
+
+        std::vector<Node> m_nodes;
+        std::vector<int> m_columnSize;
+        //Columns covered by the givens, to tell when two of them clash
+        std::vector<bool> m_givenColumns;
+        //The first node of every row picked, the givens and then the search's choices by depth
+        std::vector<int> m_picked;
+        int m_givens;
+        char* m_solution;
+        int m_solutionLimit;
+        int m_solutions;
+        int m_guesses;
+        SolveBudget* m_budget;
+        bool m_stopped;
+    };
+
+    //The row for a value in a cell covers the cell, and the value in the cell's row, column and box
+    template <int BoxSize>
+    DancingLinks<BoxSize>::DancingLinks()
+        : m_nodes(FirstRowNode + 4 * Rows)
+        , m_columnSize(1 + Columns, 0)
+        , m_givenColumns(1 + Columns, false)
+        , m_picked(CellCount)
+        , m_givens(0)
+        , m_solution(nullptr)
+        , m_solutionLimit(1)
+        , m_solutions(0)
+        , m_guesses(0)
+        , m_budget(nullptr)
+        , m_stopped(false)
+    {
+        for (auto header = 0; header <= Columns; ++header)
+        {
+            auto& node = m_nodes[header];
+            node.Left = header == 0 ? Columns : header - 1;
+            node.Right = header == Columns ? 0 : header + 1;
+            node.Up = header;
+            node.Down = header;
+            node.Column = header;
+        }
+
+        for (auto row = 0; row < Rows; ++row)
+        {
+            const auto cell = row / Size;
+            const auto value = row % Size;
+            const auto x = cell % Size;
+            const auto y = cell / Size;
+            const auto box = (y / BoxSize) * BoxSize + x / BoxSize;
+            const int columns[4] = { cell, CellCount + y * Size + value, 2 * CellCount + x * Size + value, 3 * CellCount + box * Size + value };
+
+            const auto first = FirstRowNode + 4 * row;
+            for (auto k = 0; k < 4; ++k)
+            {
+                const auto header = 1 + columns[k];
+                auto& node = m_nodes[first + k];
+                node.Left = first + (k + 3) % 4;
+                node.Right = first + (k + 1) % 4;
+                node.Column = header;
+                node.Down = header;
+                node.Up = m_nodes[header].Up;
+                m_nodes[node.Up].Down = first + k;
+                m_nodes[header].Up = first + k;
+                m_columnSize[header] += 1;
+            }
+        }
+    }
+
+    template <int BoxSize>
+    void DancingLinks<BoxSize>::Cover(int column)
+    {
+        const auto nodes = m_nodes.data();
+        nodes[nodes[column].Right].Left = nodes[column].Left;
+        nodes[nodes[column].Left].Right = nodes[column].Right;
+        for (auto i = nodes[column].Down; i != column; i = nodes[i].Down)
+        {
+            for (auto j = nodes[i].Right; j != i; j = nodes[j].Right)
+            {
+                nodes[nodes[j].Down].Up = nodes[j].Up;
+                nodes[nodes[j].Up].Down = nodes[j].Down;
+                m_columnSize[nodes[j].Column] -= 1;
+            }
+        }
+    }
+
+    template <int BoxSize>
+    void DancingLinks<BoxSize>::Uncover(int column)
+    {
+        const auto nodes = m_nodes.data();
+        for (auto i = nodes[column].Up; i != column; i = nodes[i].Up)
+        {
+            for (auto j = nodes[i].Left; j != i; j = nodes[j].Left)
+            {
+                m_columnSize[nodes[j].Column] += 1;
+                nodes[nodes[j].Down].Up = j;
+                nodes[nodes[j].Up].Down = j;
+            }
+        }
+        nodes[nodes[column].Right].Left = column;
+        nodes[nodes[column].Left].Right = column;
+    }
+
+    template <int BoxSize>
+    void DancingLinks<BoxSize>::Select(int node)
+    {
+        Cover(m_nodes[node].Column);
+        for (auto j = m_nodes[node].Right; j != node; j = m_nodes[j].Right) { Cover(m_nodes[j].Column); }
+    }
+
+    template <int BoxSize>
+    void DancingLinks<BoxSize>::Deselect(int node)
+    {
+        for (auto j = m_nodes[node].Left; j != node; j = m_nodes[j].Left) { Uncover(m_nodes[j].Column); }
+        Uncover(m_nodes[node].Column);
+    }
+
+    template <int BoxSize>
+    void DancingLinks<BoxSize>::WriteSolution(int picked)
+    {
+        for (auto i = 0; i < picked; ++i)
+        {
+            const auto row = (m_picked[i] - FirstRowNode) / 4;
+            m_solution[row / Size] = ValueChar(row % Size + 1);
+        }
+    }
+
+    //Algorithm X on the column with the fewest rows left, stopping the scan at one with a single row
+    template <int BoxSize>
+    bool DancingLinks<BoxSize>::Search(int depth)
+    {
+        const auto nodes = m_nodes.data();
+        if (nodes[0].Right == 0)
+        {
+            if (m_solutions == 0) { WriteSolution(m_givens + depth); }
+            m_solutions += 1;
+            return m_solutions >= m_solutionLimit;
+        }
+
+        auto column = nodes[0].Right;
+        auto rows = m_columnSize[column];
+        for (auto c = nodes[column].Right; c != 0 && rows > 1; c = nodes[c].Right)
+        {
+            if (m_columnSize[c] < rows)
+            {
+                column = c;
+                rows = m_columnSize[c];
+            }
+        }
+        if (rows == 0) { return false; }
+
+        Cover(column);
+        auto stop = false;
+        for (auto r = nodes[column].Down; r != column && !stop; r = nodes[r].Down)
+        {
+            if (rows > 1)
+            {
+                if (m_budget != nullptr && !m_budget->Continue(m_guesses))
+                {
+                    m_stopped = true;
+                    stop = true;
+                    break;
+                }
+                m_guesses += 1;
+            }
+            m_picked[m_givens + depth] = r;
+            for (auto j = nodes[r].Right; j != r; j = nodes[j].Right) { Cover(nodes[j].Column); }
+            stop = Search(depth + 1);
+            for (auto j = nodes[r].Left; j != r; j = nodes[j].Left) { Uncover(nodes[j].Column); }
+        }
+        Uncover(column);
+        return stop;
+    }
+
+    template <int BoxSize>
+    SolveStatus DancingLinks<BoxSize>::Solve(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses,
+        SolveBudget* budget)
+    {
+        solutions = 0;
+        guesses = 0;
+        for (auto cell = 0; cell < CellCount; ++cell)
+        {
+            const auto v = CharValue(puzzle[cell]);
+            if ((v < 1 || v > Size) && puzzle[cell] != '.' && puzzle[cell] != '0') { return SolveStatus::InvalidInput; }
+        }
+
+        auto clash = false;
+        m_givens = 0;
+        for (auto cell = 0; cell < CellCount && !clash; ++cell)
+        {
+            const auto v = CharValue(puzzle[cell]);
+            if (v < 1 || v > Size) { continue; }
+
+            const auto node = FirstRowNode + 4 * (cell * Size + v - 1);
+            for (auto k = 0; k < 4; ++k) { clash = clash || m_givenColumns[m_nodes[node + k].Column]; }
+            if (clash) { break; }
+            for (auto k = 0; k < 4; ++k) { m_givenColumns[m_nodes[node + k].Column] = true; }
+            Select(node);
+            m_picked[m_givens++] = node;
+        }
+
+        if (!clash)
+        {
+            m_solution = solution;
+            m_solutionLimit = solutionLimit < 1 ? 1 : solutionLimit;
+            m_solutions = 0;
+            m_guesses = 0;
+            m_budget = budget;
+            m_stopped = false;
+            Search(0);
+            solutions = m_solutions;
+            guesses = m_guesses;
+        }
+
+        //Back to the full matrix for the next puzzle
+        while (m_givens > 0)
+        {
+            const auto node = m_picked[--m_givens];
+            Deselect(node);
+            for (auto k = 0; k < 4; ++k) { m_givenColumns[m_nodes[node + k].Column] = false; }
+        }
+
+        if (clash) { return SolveStatus::InvalidInput; }
+        if (m_stopped) { return budget->Stopped(); }
+        return solutions > 0 ? SolveStatus::Solved : SolveStatus::Unsolvable;
+    }
+
+    template <int BoxSize>
+    SolveStatus SolveDancingLinks(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses, SolveBudget* budget)
+    {
+        static thread_local DancingLinks<BoxSize> links;
+        return links.Solve(puzzle, solution, solutionLimit, solutions, guesses, budget);
+    }
+
+    template SolveStatus SolveDancingLinks<3>(const char*, char*, int, int&, int&, SolveBudget*);
+    template SolveStatus SolveDancingLinks<4>(const char*, char*, int, int&, int&, SolveBudget*);
+    template SolveStatus SolveDancingLinks<5>(const char*, char*, int, int&, int&, SolveBudget*);
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "Board.h"
+
+namespace Solver
+{
+	//Solves a puzzle of CellCount characters in row order as an exact cover problem with Dancing Links
+	//Every cell and value is a row covering four columns: the cell, and the value in its row, its column and its box
+	//The matrix lives in one arena built the first time each thread solves a grid of this size. Givens are covered
+	//before the search and uncovered after it, so the arena is back to the full matrix for the next puzzle.
+	//The first solution is written to solution as CellCount characters, solution is left alone if there is none
+	//Stops once solutionLimit solutions are found, solutions is how many were, guesses how many rows were tried in
+	//columns that had more than one. Givens that clash are InvalidInput, the same as SetInitialData.
+	//A budget, if given, is checked before every guess
+	template <int BoxSize>
+	SolveStatus SolveDancingLinks(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses, SolveBudget* budget);
+}
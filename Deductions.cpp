@@ -0,0 +1,324 @@
+#include <string.h>
+#include <string>
+
+#include "Bits.h"
+#include "Board.h"
+#include "Deductions.h"
+
+namespace Solver
+{
+    //Calls found(chosen, covered) for every set of size entries whose masks together cover exactly size bits
+    //chosen has a bit per entry picked, covered is the union of their masks
+    //Entries with no bits or more than size bits can't be part of such a set and are skipped
+    template <typename Mask, int Count, typename Found>
+    void FindSubsets(Mask const (&masks)[Count], int size, Found found)
+    {
+        using Chosen = MaskFor<Count>;
+        int entries[Count];
+        auto count = 0;
+        for (auto i = 0; i < Count; ++i)
+        {
+            const auto bits = CountBits(masks[i]);
+            if (bits != 0 && bits <= size) { entries[count++] = i; }
+        }
+
+        for (auto a = 0; a < count; ++a)
+        {
+            for (auto b = a + 1; b < count; ++b)
+            {
+                const auto pair = (Mask)(masks[entries[a]] | masks[entries[b]]);
+                const auto pairBits = CountBits(pair);
+                const auto pairChosen = (Chosen)(((Chosen)1 << entries[a]) | ((Chosen)1 << entries[b]));
+                if (size == 2)
+                {
+                    if (pairBits == 2) { found(pairChosen, pair); }
+                    continue;
+                }
+                if (pairBits > 3) { continue; }
+
+                for (auto c = b + 1; c < count; ++c)
+                {
+                    const auto triple = (Mask)(pair | masks[entries[c]]);
+                    if (CountBits(triple) == 3) { found((Chosen)(pairChosen | ((Chosen)1 << entries[c])), triple); }
+                }
+            }
+        }
+    }
+
+    //Removes the values in mask from a cell, returns true if any were there
+    template <int BoxSize>
+    bool RemoveCandidates(BasicBoard<BoxSize>& board, int cell, typename BasicBoard<BoxSize>::Mask mask)
+    {
+        auto present = (typename BasicBoard<BoxSize>::Mask)(board.GetCandidates(cell) & mask);
+        if (present == 0) { return false; }
+
+        for (; present != 0; present &= present - 1)
+        {
+            board.RemoveCandidate(cell, (int)LowestBit(present) + 1);
+        }
+        return true;
+    }
+
+    //Cells of a unit whose candidates together are just size values, so no other cell in the unit can have them
+    template <int BoxSize>
+    bool NakedSubsets(BasicBoard<BoxSize>& board, int size)
+    {
+        using Grid = BasicBoard<BoxSize>;
+        auto changed = false;
+        for (auto unit = 0; unit < Grid::UnitCount && board.IsValid(); ++unit)
+        {
+            auto const* cells = Grid::GetUnitCells(unit);
+            typename Grid::Mask masks[Grid::Size];
+            for (auto i = 0; i < Grid::Size; ++i) { masks[i] = board.GetCandidates(cells[i]); }
+
+            FindSubsets(masks, size, [&](typename Grid::Mask chosen, typename Grid::Mask values) {
+                for (auto i = 0; i < Grid::Size; ++i)
+                {
+                    if ((chosen & ((typename Grid::Mask)1 << i)) == 0) { changed |= RemoveCandidates(board, cells[i], values); }
+                }
+            });
+        }
+        return changed;
+    }
+
+    //Values of a unit that only fit in the same size cells, so those cells can't hold anything else
+    template <int BoxSize>
+    bool HiddenSubsets(BasicBoard<BoxSize>& board, int size)
+    {
+        using Grid = BasicBoard<BoxSize>;
+        auto changed = false;
+        for (auto unit = 0; unit < Grid::UnitCount && board.IsValid(); ++unit)
+        {
+            auto const* cells = Grid::GetUnitCells(unit);
+            typename Grid::Mask places[Grid::Size];
+            for (auto v = 1; v <= Grid::Size; ++v) { places[v - 1] = board.GetPlaces(unit, v); }
+
+            FindSubsets(places, size, [&](typename Grid::Mask values, typename Grid::Mask chosen) {
+                for (auto bits = chosen; bits != 0; bits &= bits - 1)
+                {
+                    changed |= RemoveCandidates(board, cells[LowestBit(bits)], (typename Grid::Mask)~values);
+                }
+            });
+        }
+        return changed;
+    }
+
+    //Removes v from every cell of a unit outside of the keep positions
+    template <int BoxSize>
+    bool RemoveFromUnit(BasicBoard<BoxSize>& board, int unit, int v, typename BasicBoard<BoxSize>::Mask keep)
+    {
+        auto changed = false;
+        auto const* cells = BasicBoard<BoxSize>::GetUnitCells(unit);
+        for (auto bits = (typename BasicBoard<BoxSize>::Mask)(board.GetPlaces(unit, v) & ~keep); bits != 0; bits &= bits - 1)
+        {
+            board.RemoveCandidate(cells[LowestBit(bits)], v);
+            changed = true;
+        }
+        return changed;
+    }
+
+    //Positions of the units that are handy for the box and line techniques
+    //Units are the rows, then the columns, then the boxes, and box positions are numbered in row order
+    template <int BoxSize>
+    struct Shapes
+    {
+        using Grid = BasicBoard<BoxSize>;
+        using Mask = typename Grid::Mask;
+        static const int FirstRow = 0;
+        static const int FirstColumn = Grid::Size;
+        static const int FirstBox = 2 * Grid::Size;
+
+        //One row of a box, which is also one box worth of a line
+        static Mask Span() { return (Mask)(((Mask)1 << BoxSize) - 1); }
+        //One column of a box
+        static Mask BoxColumn()
+        {
+            auto column = (Mask)0;
+            for (auto i = 0; i < BoxSize; ++i) { column |= (Mask)((Mask)1 << (i * BoxSize)); }
+            return column;
+        }
+    };
+
+    //A digit whose places in a box all share a row or column is taken out of the rest of that line
+    template <int BoxSize>
+    bool Pointing(BasicBoard<BoxSize>& board)
+    {
+        using Shape = Shapes<BoxSize>;
+        using Mask = typename Shape::Mask;
+        auto changed = false;
+        for (auto box = 0; box < Shape::Grid::Size && board.IsValid(); ++box)
+        {
+            const auto top = (box / BoxSize) * BoxSize;
+            const auto left = (box % BoxSize) * BoxSize;
+            for (auto v = 1; v <= Shape::Grid::Size; ++v)
+            {
+                const auto places = board.GetPlaces(Shape::FirstBox + box, v);
+                if (places == 0) { continue; }
+
+                for (auto line = 0; line < BoxSize; ++line)
+                {
+                    if ((places & ~(Mask)(Shape::Span() << (line * BoxSize))) == 0)
+                    {
+                        changed |= RemoveFromUnit(board, Shape::FirstRow + top + line, v, (Mask)(Shape::Span() << left));
+                    }
+                    if ((places & ~(Mask)(Shape::BoxColumn() << line)) == 0)
+                    {
+                        changed |= RemoveFromUnit(board, Shape::FirstColumn + left + line, v, (Mask)(Shape::Span() << top));
+                    }
+                }
+            }
+        }
+        return changed;
+    }
+
+    //A digit whose places in a row or column all fall in one box is taken out of the rest of that box
+    template <int BoxSize>
+    bool BoxLine(BasicBoard<BoxSize>& board)
+    {
+        using Shape = Shapes<BoxSize>;
+        using Mask = typename Shape::Mask;
+        auto changed = false;
+        for (auto line = 0; line < Shape::Grid::Size && board.IsValid(); ++line)
+        {
+            for (auto v = 1; v <= Shape::Grid::Size; ++v)
+            {
+                const auto rowPlaces = board.GetPlaces(Shape::FirstRow + line, v);
+                const auto columnPlaces = board.GetPlaces(Shape::FirstColumn + line, v);
+                for (auto part = 0; part < BoxSize; ++part)
+                {
+                    const auto span = (Mask)(Shape::Span() << (part * BoxSize));
+                    if (rowPlaces != 0 && (rowPlaces & ~span) == 0)
+                    {
+                        const auto box = (line / BoxSize) * BoxSize + part;
+                        changed |= RemoveFromUnit(board, Shape::FirstBox + box, v, (Mask)(Shape::Span() << ((line % BoxSize) * BoxSize)));
+                    }
+                    if (columnPlaces != 0 && (columnPlaces & ~span) == 0)
+                    {
+                        const auto box = part * BoxSize + line / BoxSize;
+                        changed |= RemoveFromUnit(board, Shape::FirstBox + box, v, (Mask)(Shape::BoxColumn() << (line % BoxSize)));
+                    }
+                }
+            }
+        }
+        return changed;
+    }
+
+    //size rows whose places for a digit cover just size columns, so the digit leaves the rest of those columns
+    //Same again with rows and columns swapped, size 2 is an X-Wing and size 3 a Swordfish
+    template <int BoxSize>
+    bool Fish(BasicBoard<BoxSize>& board, int size)
+    {
+        using Shape = Shapes<BoxSize>;
+        using Mask = typename Shape::Mask;
+        auto changed = false;
+        for (auto v = 1; v <= Shape::Grid::Size && board.IsValid(); ++v)
+        {
+            for (auto base = Shape::FirstRow; base <= Shape::FirstColumn; base += Shape::FirstColumn)
+            {
+                const auto cover = base == Shape::FirstRow ? Shape::FirstColumn : Shape::FirstRow;
+                Mask places[Shape::Grid::Size];
+                for (auto line = 0; line < Shape::Grid::Size; ++line) { places[line] = board.GetPlaces(base + line, v); }
+
+                FindSubsets(places, size, [&](Mask lines, Mask covered) {
+                    for (auto bits = covered; bits != 0; bits &= bits - 1)
+                    {
+                        changed |= RemoveFromUnit(board, cover + (int)LowestBit(bits), v, lines);
+                    }
+                });
+            }
+        }
+        return changed;
+    }
+
+    template <int BoxSize>
+    bool Apply(BasicBoard<BoxSize>& board, Deduction deduction)
+    {
+        switch (deduction)
+        {
+        case NakedPairs: return NakedSubsets(board, 2);
+        case NakedTriples: return NakedSubsets(board, 3);
+        case HiddenPairs: return HiddenSubsets(board, 2);
+        case HiddenTriples: return HiddenSubsets(board, 3);
+        case PointingPairs: return Pointing(board);
+        case BoxLineReduction: return BoxLine(board);
+        case XWing: return Fish(board, 2);
+        case Swordfish: return Fish(board, 3);
+        default: return false;
+        }
+    }
+
+    //Cheapest first, the pipeline starts over from the top after anything is removed
+    static const Deduction Pipeline[] = {
+        PointingPairs, BoxLineReduction, NakedPairs, HiddenPairs, XWing, NakedTriples, HiddenTriples, Swordfish
+    };
+
+    template <int BoxSize>
+    bool Deduce(BasicBoard<BoxSize>& board, unsigned int deductions)
+    {
+        while (board.SolveKnown() && !board.IsSolved())
+        {
+            auto changed = false;
+            for (auto deduction : Pipeline)
+            {
+                if ((deductions & deduction) && Apply(board, deduction))
+                {
+                    changed = true;
+                    break;
+                }
+            }
+            if (!changed) { break; }
+        }
+        return board.IsValid();
+    }
+
+    const char* GetDeductionName(Deduction deduction)
+    {
+        switch (deduction)
+        {
+        case NakedPairs: return "naked2";
+        case NakedTriples: return "naked3";
+        case HiddenPairs: return "hidden2";
+        case HiddenTriples: return "hidden3";
+        case PointingPairs: return "pointing";
+        case BoxLineReduction: return "boxline";
+        case XWing: return "xwing";
+        case Swordfish: return "swordfish";
+        default: return "none";
+        }
+    }
+
+    bool ParseDeductions(const char* names, unsigned int& deductions)
+    {
+        if (strcmp(names, "all") == 0) { deductions = AllDeductions; return true; }
+        if (strcmp(names, "none") == 0) { deductions = NoDeductions; return true; }
+
+        auto parsed = 0u;
+        const std::string list = names;
+        size_t begin = 0;
+        while (begin <= list.size())
+        {
+            auto end = list.find(',', begin);
+            if (end == std::string::npos) { end = list.size(); }
+            const auto name = list.substr(begin, end - begin);
+
+            auto found = false;
+            for (auto deduction : Pipeline)
+            {
+                if (name == GetDeductionName(deduction))
+                {
+                    parsed |= deduction;
+                    found = true;
+                }
+            }
+            if (!found) { return false; }
+            begin = end + 1;
+        }
+
+        deductions = parsed;
+        return true;
+    }
+
+    template bool Deduce<3>(BasicBoard<3>& board, unsigned int deductions);
+    template bool Deduce<4>(BasicBoard<4>& board, unsigned int deductions);
+    template bool Deduce<5>(BasicBoard<5>& board, unsigned int deductions);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace Solver
+{
+	template <int BoxSize>
+	class BasicBoard;
+
+	//Techniques tried on the candidate masks when singles run out, before the search falls back to guessing
+	//Combine the flags to pick which ones run
+	enum Deduction : unsigned int
+	{
+		NakedPairs = 1 << 0,
+		NakedTriples = 1 << 1,
+		HiddenPairs = 1 << 2,
+		HiddenTriples = 1 << 3,
+		//A digit confined to one row or column of a box can't go anywhere else in that line
+		PointingPairs = 1 << 4,
+		//A digit confined to one box within a line can't go anywhere else in that box
+		BoxLineReduction = 1 << 5,
+		XWing = 1 << 6,
+		Swordfish = 1 << 7,
+
+		NoDeductions = 0,
+		AllDeductions = (1 << 8) - 1
+	};
+
+	static const unsigned int DefaultDeductions = NoDeductions;
+
+	//Apply the chosen techniques until none of them removes anything, placing any singles they uncover
+	//Cheap techniques go first and the pipeline starts over from them after every success
+	//Returns false if the board turns out to have no solution
+	template <int BoxSize>
+	bool Deduce(BasicBoard<BoxSize>& board, unsigned int deductions);
+
+	//Names are the ones used on the command line: naked2, naked3, hidden2, hidden3, pointing, boxline, xwing, swordfish
+	const char* GetDeductionName(Deduction deduction);
+	//Reads a comma separated list of names, or all or none
+	bool ParseDeductions(const char* names, unsigned int& deductions);
+}
@@ -0,0 +1,140 @@
+#include <string.h>
+#include <algorithm>
+
+#include "BitboardEngine.h"
+#include "Board.h"
+#include "DancingLinks.h"
+#include "Engine.h"
+
+namespace Solver
+{
+    SolveBudget::SolveBudget(int guessLimit, int timeLimitMs, Clock::time_point deadline, CancelToken const* cancel)
+        : m_guessLimit(guessLimit)
+        , m_deadline(deadline)
+        , m_cancel(cancel)
+        , m_untilClock(ClockInterval)
+        , m_exceeded(false)
+    {
+        if (timeLimitMs > 0) { m_deadline = std::min(m_deadline, Clock::now() + std::chrono::milliseconds(timeLimitMs)); }
+        m_timed = m_deadline != Clock::time_point::max();
+        m_limited = m_guessLimit > 0 || m_timed || m_cancel != nullptr;
+    }
+
+    SolveStatus SolveBudget::Stopped() const
+    {
+        return m_exceeded ? SolveStatus::BudgetExceeded : SolveStatus::Cancelled;
+    }
+
+    //The boards of Solve and CountSolutions, with a stack kept for each thread like SolvePuzzle
+    template <int BoxSize>
+    class MasksEngine : public BasicSolverEngine<BoxSize>
+    {
+    public:
+        SolveStatus Solve(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses,
+            SolveBudget* budget) const override
+        {
+            using Board = BasicBoard<BoxSize>;
+            static thread_local BasicMoveStack<BoxSize> boardStack;
+            solutions = 0;
+            guesses = 0;
+            auto board = Board();
+            if (!Board::FromLine(puzzle, board)) { return SolveStatus::InvalidInput; }
+
+            auto options = BasicSolveOptions<BoxSize>();
+            options.SolutionLimit = solutionLimit;
+            auto result = Board();
+            const auto status = CountSolutions<BoxSize>(board, result, solutions, guesses, boardStack, options, budget);
+            if (status == SolveStatus::Solved) { result.ToLine(solution); }
+            return status;
+        }
+    };
+
+    class BitboardSolverEngine : public BasicSolverEngine<3>
+    {
+    public:
+        SolveStatus Solve(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses,
+            SolveBudget* budget) const override
+        {
+            return SolveBitboard(puzzle, solution, solutionLimit, solutions, guesses, budget);
+        }
+    };
+
+    template <int BoxSize>
+    class DancingLinksEngine : public BasicSolverEngine<BoxSize>
+    {
+    public:
+        SolveStatus Solve(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses,
+            SolveBudget* budget) const override
+        {
+            return SolveDancingLinks<BoxSize>(puzzle, solution, solutionLimit, solutions, guesses, budget);
+        }
+    };
+
+    bool EngineSupports(Engine engine, int boxSize)
+    {
+        switch (engine)
+        {
+        case Engine::Bitboard: return boxSize == 3;
+        case Engine::DancingLinks:
+        case Engine::Masks:
+        default: return true;
+        }
+    }
+
+    Engine EngineFor(Engine engine, int boxSize)
+    {
+        return EngineSupports(engine, boxSize) ? engine : Engine::Masks;
+    }
+
+    //Only 9x9 has a bitboard engine
+    template <int BoxSize>
+    BasicSolverEngine<BoxSize> const* GetBitboardEngine()
+    {
+        return nullptr;
+    }
+
+    template <>
+    BasicSolverEngine<3> const* GetBitboardEngine<3>()
+    {
+        static const BitboardSolverEngine bitboard;
+        return &bitboard;
+    }
+
+    template <int BoxSize>
+    BasicSolverEngine<BoxSize> const& GetSolverEngine(Engine engine)
+    {
+        static const MasksEngine<BoxSize> masks;
+        static const DancingLinksEngine<BoxSize> dancingLinks;
+        switch (EngineFor(engine, BoxSize))
+        {
+        case Engine::Bitboard: return *GetBitboardEngine<BoxSize>();
+        case Engine::DancingLinks: return dancingLinks;
+        case Engine::Masks:
+        default: return masks;
+        }
+    }
+
+    const char* GetEngineName(Engine engine)
+    {
+        switch (engine)
+        {
+        case Engine::Bitboard: return "bitboard";
+        case Engine::DancingLinks: return "dlx";
+        case Engine::Masks:
+        default: return "masks";
+        }
+    }
+
+    bool ParseEngine(const char* name, Engine& engine)
+    {
+        if (strcmp(name, "masks") == 0) { engine = Engine::Masks; }
+        else if (strcmp(name, "bitboard") == 0) { engine = Engine::Bitboard; }
+        else if (strcmp(name, "dlx") == 0) { engine = Engine::DancingLinks; }
+        else { return false; }
+        return true;
+    }
+
+    template BasicSolverEngine<3> const& GetSolverEngine<3>(Engine engine);
+    template BasicSolverEngine<4> const& GetSolverEngine<4>(Engine engine);
+    template BasicSolverEngine<5> const& GetSolverEngine<5>(Engine engine);
+}
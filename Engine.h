@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+
+namespace Solver
+{
+	enum class SolveStatus;
+
+	//How a solve represents the grid and searches it
+	enum class Engine
+	{
+		//Candidate masks per cell and per unit, singles placed from a queue, every grid size
+		Masks,
+		//A bitboard per digit split into three bands of 27 cells, 9x9 only, the other sizes use Masks
+		Bitboard,
+		//Exact cover with Dancing Links, every grid size
+		DancingLinks
+	};
+
+	//Shared between a caller and its solves, cancelling stops each of them at its next guess
+	class CancelToken
+	{
+	public:
+		void Cancel()
+		{
+			m_cancelled.store(true, std::memory_order_relaxed);
+		}
+
+		void Reset()
+		{
+			m_cancelled.store(false, std::memory_order_relaxed);
+		}
+
+		bool Cancelled() const
+		{
+			return m_cancelled.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<bool> m_cancelled{ false };
+	};
+
+	//The guess, time and cancel limits of one solve, started with the solve so its time covers setting up too
+	//Every engine asks it before each guess and stops once it says no
+	class SolveBudget
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		//The clock is read every this many guesses, often enough to overshoot by well under a millisecond
+		static const int ClockInterval = 16;
+
+		//Limits of 0 are none, as is a deadline of time_point::max() and a null token
+		SolveBudget(int guessLimit, int timeLimitMs, Clock::time_point deadline, CancelToken const* cancel);
+
+		//Whether there is anything to check, a solve without limits is given no budget so it never makes the call
+		bool Limited() const
+		{
+			return m_limited;
+		}
+
+		//guesses is how many the search has made so far
+		bool Continue(int guesses)
+		{
+			if (m_cancel != nullptr && m_cancel->Cancelled()) { return false; }
+			if (m_guessLimit > 0 && guesses >= m_guessLimit) { m_exceeded = true; }
+			else if (m_timed && --m_untilClock == 0)
+			{
+				m_untilClock = ClockInterval;
+				m_exceeded = Clock::now() >= m_deadline;
+			}
+			return !m_exceeded;
+		}
+
+		//What a search this stopped ends with
+		SolveStatus Stopped() const;
+
+	private:
+		int m_guessLimit;
+		Clock::time_point m_deadline;
+		CancelToken const* m_cancel;
+		int m_untilClock;
+		bool m_exceeded;
+		bool m_timed;
+		bool m_limited;
+	};
+
+	//Solves puzzles given as CellCount characters in row order, the same cells batch mode reads
+	//Engines hold no state of their own, what they work in is kept per thread, so one can be shared by every thread
+	template <int BoxSize>
+	class BasicSolverEngine
+	{
+	public:
+		virtual ~BasicSolverEngine() = default;
+
+		//Finds up to solutionLimit solutions and writes the first to solution as CellCount characters,
+		//solution is left alone if there is none. guesses counts the choices the search made, each engine in its own way
+		//A budget, when there is one, is checked before every guess and a solve it stops ends with its Stopped status
+		virtual SolveStatus Solve(const char* puzzle, char* solution, int solutionLimit, int& solutions, int& guesses,
+			SolveBudget* budget) const = 0;
+	};
+
+	using SolverEngine = BasicSolverEngine<3>;
+
+	//Whether an engine has code for this box size
+	bool EngineSupports(Engine engine, int boxSize);
+	//The engine that runs for this box size, Masks when the one asked for has no code for it
+	Engine EngineFor(Engine engine, int boxSize);
+	template <int BoxSize = 3>
+	BasicSolverEngine<BoxSize> const& GetSolverEngine(Engine engine);
+	//Names are masks, bitboard and dlx
+	const char* GetEngineName(Engine engine);
+	bool ParseEngine(const char* name, Engine& engine);
+}
@@ -0,0 +1,182 @@
+#include "FileIo.h"
+
+#include <string.h>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SUDOKU_MMAP 1
+#else
+#define SUDOKU_MMAP 0
+#endif
+
+namespace Solver
+{
+    MappedFile::MappedFile()
+        : m_data(nullptr)
+        , m_size(0)
+        , m_mapped(false)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+#if SUDOKU_MMAP
+    //The file can be closed once it is mapped, the mapping keeps it alive
+    bool MappedFile::Open(const char* path)
+    {
+        Close();
+        const auto file = open(path, O_RDONLY);
+        if (file < 0) { return false; }
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            close(file);
+            return false;
+        }
+
+        m_size = (size_t)info.st_size;
+        if (m_size > 0)
+        {
+            auto data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (data == MAP_FAILED)
+            {
+                close(file);
+                m_size = 0;
+                return false;
+            }
+            //Lines are read front to back, so let the kernel read ahead as far as it likes
+            madvise(data, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(data);
+            m_mapped = true;
+        }
+        close(file);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_mapped) { munmap(const_cast<char*>(m_data), m_size); }
+        m_data = nullptr;
+        m_size = 0;
+        m_mapped = false;
+    }
+#else
+    //Without mmap the whole file is read in with one call, which is still far cheaper than line by line
+    bool MappedFile::Open(const char* path)
+    {
+        Close();
+        auto file = fopen(path, "rb");
+        if (file == nullptr) { return false; }
+
+        auto ok = fseek(file, 0, SEEK_END) == 0;
+        const auto size = ok ? ftell(file) : -1L;
+        ok = size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+        if (ok)
+        {
+            m_buffer.resize((size_t)size);
+            ok = fread(m_buffer.data(), 1, m_buffer.size(), file) == m_buffer.size();
+        }
+        fclose(file);
+        if (!ok)
+        {
+            Close();
+            return false;
+        }
+
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        m_buffer.clear();
+        m_data = nullptr;
+        m_size = 0;
+    }
+#endif
+
+    const char* MappedFile::Data() const
+    {
+        return m_data;
+    }
+
+    size_t MappedFile::Size() const
+    {
+        return m_size;
+    }
+
+    //Blank lines are skipped and a trailing \r is dropped, the same as ReadPuzzleLine does for streams
+    bool NextLine(const char*& position, const char* end, LineRef& line)
+    {
+        while (position < end)
+        {
+            auto next = static_cast<const char*>(memchr(position, '\n', end - position));
+            if (next == nullptr) { next = end; }
+
+            line.Data = position;
+            line.Length = next - position;
+            position = next < end ? next + 1 : end;
+            if (line.Length > 0 && line.Data[line.Length - 1] == '\r') { line.Length -= 1; }
+            if (line.Length > 0) { return true; }
+        }
+        return false;
+    }
+
+    BufferedWriter::BufferedWriter(FILE* file, size_t capacity)
+        : m_file(file)
+        , m_buffer(new char[capacity])
+        , m_capacity(capacity)
+        , m_used(0)
+        , m_failed(false)
+    {
+    }
+
+    BufferedWriter::~BufferedWriter()
+    {
+        Flush();
+    }
+
+    void BufferedWriter::Write(const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            if (m_used == m_capacity) { Flush(); }
+            const auto count = std::min(size, m_capacity - m_used);
+            memcpy(&m_buffer[m_used], data, count);
+            m_used += count;
+            data += count;
+            size -= count;
+        }
+    }
+
+    char* BufferedWriter::Reserve(size_t size)
+    {
+        if (m_capacity - m_used < size) { Flush(); }
+        return &m_buffer[m_used];
+    }
+
+    void BufferedWriter::Commit(size_t size)
+    {
+        m_used += size;
+    }
+
+    bool BufferedWriter::Flush()
+    {
+        if (m_used > 0)
+        {
+            if (fwrite(m_buffer.get(), 1, m_used, m_file) != m_used) { m_failed = true; }
+            m_used = 0;
+        }
+        if (fflush(m_file) != 0) { m_failed = true; }
+        return !m_failed;
+    }
+}
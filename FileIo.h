@@ -0,0 +1,71 @@
+#pragma once
+#include <stdio.h>
+#include <stddef.h>
+#include <memory>
+#include <vector>
+
+namespace Solver
+{
+	//A whole file as one read-only block of memory, mapped where the OS supports it and read in otherwise
+	//Lines are parsed straight out of the mapping, so nothing is copied on the way in
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+		MappedFile(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+
+		//Fails for anything that can't be opened or mapped, pipes included, so callers can fall back to streaming
+		bool Open(const char* path);
+		const char* Data() const;
+		size_t Size() const;
+
+	private:
+		void Close();
+
+		const char* m_data;
+		size_t m_size;
+		bool m_mapped;
+		std::vector<char> m_buffer;
+	};
+
+	//A line within a buffer, read in place
+	struct LineRef
+	{
+		const char* Data;
+		size_t Length;
+	};
+
+	//Step to the next non-blank line of a buffer, dropping the line ending, returns false at the end
+	bool NextLine(const char*& position, const char* end, LineRef& line);
+
+	//Collects output into one large buffer and writes it out whenever it fills
+	//Results can be formatted straight into the buffer with Reserve and Commit to skip a copy
+	class BufferedWriter
+	{
+	public:
+		static const size_t DefaultCapacity = size_t(1) << 20;
+
+		explicit BufferedWriter(FILE* file, size_t capacity = DefaultCapacity);
+		//Flushes whatever is left
+		~BufferedWriter();
+		BufferedWriter(BufferedWriter const&) = delete;
+		BufferedWriter& operator=(BufferedWriter const&) = delete;
+
+		void Write(const char* data, size_t size);
+		//Room for at least size characters, flushing first if needed, size must not be more than the capacity
+		char* Reserve(size_t size);
+		//Keep the first size characters written since Reserve
+		void Commit(size_t size);
+		//Returns false if any write so far has failed
+		bool Flush();
+
+	private:
+		FILE* m_file;
+		std::unique_ptr<char[]> m_buffer;
+		size_t m_capacity;
+		size_t m_used;
+		bool m_failed;
+	};
+}
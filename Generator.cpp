@@ -0,0 +1,278 @@
+#include "Generator.h"
+#include "Board.h"
+#include "ThreadPool.h"
+
+#include <string.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Solver
+{
+    bool ParseSymmetry(const char* name, Symmetry& symmetry)
+    {
+        if (strcmp(name, "none") == 0) { symmetry = Symmetry::None; }
+        else if (strcmp(name, "rotational") == 0) { symmetry = Symmetry::Rotational; }
+        else if (strcmp(name, "mirror") == 0) { symmetry = Symmetry::Mirror; }
+        else if (strcmp(name, "diagonal") == 0) { symmetry = Symmetry::Diagonal; }
+        else { return false; }
+        return true;
+    }
+
+    //Spreads nearby seeds far apart so puzzle i and i + 1 get unrelated streams
+    uint64_t MixSeed(uint64_t seed)
+    {
+        seed += 0x9e3779b97f4a7c15ull;
+        seed = (seed ^ (seed >> 30)) * 0xbf58476d1ce4e5b9ull;
+        seed = (seed ^ (seed >> 27)) * 0x94d049bb133111ebull;
+        return seed ^ (seed >> 31);
+    }
+
+    //The engine's output is fixed by the standard, unlike the library's distributions and shuffle
+    //Taking it modulo is a little uneven, but nowhere near enough to matter for at most 625 choices
+    int RandomBelow(std::mt19937_64& random, int count)
+    {
+        return (int)(random() % (uint64_t)count);
+    }
+
+    //Fewest candidates like the default strategy, but with a random value, so filling an empty board gives a random grid
+    //Unlike the shared strategies this one draws from a generator, so each worker needs its own
+    template <int BoxSize>
+    class RandomValueStrategy : public BasicBranchStrategy<BoxSize>
+    {
+    public:
+        explicit RandomValueStrategy(std::mt19937_64& random) : m_random(random) {}
+
+        CellGuess Choose(BasicBoard<BoxSize> const& board) const override
+        {
+            const auto size = BasicBoard<BoxSize>::Size;
+            auto best = -1;
+            auto bestCount = size + 1;
+            for (auto cell = 0; cell < BasicBoard<BoxSize>::CellCount; ++cell)
+            {
+                const auto mask = board.GetCandidates(cell);
+                if (mask == 0) { continue; }
+
+                const auto count = CountBits(mask);
+                if (count < bestCount)
+                {
+                    best = cell;
+                    bestCount = count;
+                    if (count <= 2) { break; }
+                }
+            }
+
+            //Skip a random number of the candidates and take the next one
+            auto mask = board.GetCandidates(best);
+            for (auto skip = RandomBelow(m_random, bestCount); skip > 0; --skip)
+            {
+                mask &= mask - 1;
+            }
+            return CellGuess(best % size, best / size, (int)LowestBit(mask) + 1);
+        }
+
+    private:
+        std::mt19937_64& m_random;
+    };
+
+    //Cells that are given or taken away together, Second is -1 for a cell that is its own partner
+    struct Orbit
+    {
+        int First;
+        int Second;
+    };
+
+    template <int BoxSize>
+    int SymmetricCell(int cell, Symmetry symmetry)
+    {
+        const auto size = BasicBoard<BoxSize>::Size;
+        const auto x = cell % size;
+        const auto y = cell / size;
+        switch (symmetry)
+        {
+        case Symmetry::Rotational: return (size - 1 - y) * size + (size - 1 - x);
+        case Symmetry::Mirror: return y * size + (size - 1 - x);
+        case Symmetry::Diagonal: return x * size + y;
+        case Symmetry::None:
+        default: return cell;
+        }
+    }
+
+    //Everything a worker needs to build puzzles, kept between puzzles so only the first one allocates
+    template <int BoxSize>
+    struct GeneratorState
+    {
+        BasicMoveStack<BoxSize> BoardStack;
+        std::string Grid;
+        std::string Puzzle;
+        std::string Best;
+        std::vector<Orbit> Orbits;
+        GenerateSummary Summary;
+        char Padding[64];
+    };
+
+    //Fill an empty board by searching it with random values, an empty board always has a solution
+    template <int BoxSize>
+    void FillGrid(std::mt19937_64& random, GeneratorState<BoxSize>& state)
+    {
+        using Board = BasicBoard<BoxSize>;
+        const auto strategy = RandomValueStrategy<BoxSize>(random);
+        auto options = BasicSolveOptions<BoxSize>();
+        options.Strategy = &strategy;
+
+        auto solution = Board();
+        auto guesses = 0;
+        Solve<BoxSize>(Board(), solution, guesses, state.BoardStack, options);
+        state.Summary.Guesses += guesses;
+        state.Summary.Grids += 1;
+
+        state.Grid.resize(Board::CellCount);
+        solution.ToLine(&state.Grid[0]);
+    }
+
+    //True if every solution of the puzzle has v in the cell
+    //The puzzle was unique before the cell was emptied, so this is all it takes to know it still is
+    template <int BoxSize>
+    bool ForcesValue(std::string const& puzzle, int cell, int v, GeneratorState<BoxSize>& state)
+    {
+        using Board = BasicBoard<BoxSize>;
+        auto board = Board();
+        Board::FromLine(puzzle, board);
+        state.BoardStack.Reset(board);
+        state.Summary.Checks += 1;
+
+        //Look for a solution with anything else in the cell
+        auto& bottom = state.BoardStack.Top().Board;
+        bottom.SetInitialData();
+        bottom.RemoveCandidate(cell, v);
+        if (!bottom.SolveKnown()) { return true; }
+
+        auto guesses = 0;
+        const auto status = Search<BoxSize>(state.BoardStack, guesses, BasicSolveOptions<BoxSize>(), nullptr, nullptr);
+        state.Summary.Guesses += guesses;
+        return status == SolveStatus::Unsolvable;
+    }
+
+    //Take clues away from the full grid in a random order until none can go or the target is reached, returns the clues left
+    template <int BoxSize>
+    int RemoveClues(std::mt19937_64& random, GeneratorState<BoxSize>& state, GenerateOptions const& options)
+    {
+        const auto cellCount = BasicBoard<BoxSize>::CellCount;
+        auto& orbits = state.Orbits;
+        orbits.clear();
+        for (auto cell = 0; cell < cellCount; ++cell)
+        {
+            const auto partner = SymmetricCell<BoxSize>(cell, options.Symmetry);
+            if (partner < cell) { continue; }
+            orbits.push_back(Orbit{ cell, partner == cell ? -1 : partner });
+        }
+        for (auto i = (int)orbits.size() - 1; i > 0; --i)
+        {
+            std::swap(orbits[i], orbits[RandomBelow(random, i + 1)]);
+        }
+
+        auto& puzzle = state.Puzzle;
+        puzzle = state.Grid;
+        auto clues = cellCount;
+        for (auto const& orbit : orbits)
+        {
+            const auto removed = orbit.Second < 0 ? 1 : 2;
+            if (clues - removed < options.TargetClues) { continue; }
+
+            puzzle[orbit.First] = '.';
+            if (orbit.Second >= 0) { puzzle[orbit.Second] = '.'; }
+
+            auto unique = ForcesValue(puzzle, orbit.First, CharValue(state.Grid[orbit.First]), state);
+            if (unique && orbit.Second >= 0)
+            {
+                unique = ForcesValue(puzzle, orbit.Second, CharValue(state.Grid[orbit.Second]), state);
+            }
+
+            if (unique)
+            {
+                clues -= removed;
+                if (clues <= options.TargetClues) { break; }
+            }
+            else
+            {
+                puzzle[orbit.First] = state.Grid[orbit.First];
+                if (orbit.Second >= 0) { puzzle[orbit.Second] = state.Grid[orbit.Second]; }
+            }
+        }
+        return clues;
+    }
+
+    //Build puzzle index into line, trying fresh grids until one gets down to the target or the attempts run out
+    template <int BoxSize>
+    void GeneratePuzzle(size_t index, char* line, GeneratorState<BoxSize>& state, GenerateOptions const& options)
+    {
+        const auto cellCount = BasicBoard<BoxSize>::CellCount;
+        std::mt19937_64 random(MixSeed(options.Seed ^ MixSeed(index)));
+
+        //Without a target the first grid is taken down as far as it goes, so there is nothing to retry for
+        const auto attempts = options.TargetClues > 0 ? std::max(1, options.Attempts) : 1;
+        auto bestClues = cellCount + 1;
+        for (auto attempt = 0; attempt < attempts && bestClues > options.TargetClues; ++attempt)
+        {
+            FillGrid(random, state);
+            const auto clues = RemoveClues(random, state, options);
+            if (clues < bestClues)
+            {
+                bestClues = clues;
+                state.Best = state.Puzzle;
+            }
+        }
+
+        state.Summary.Puzzles += 1;
+        state.Summary.Clues += bestClues;
+        if (options.TargetClues > 0 && bestClues > options.TargetClues) { state.Summary.AboveTarget += 1; }
+        std::copy(state.Best.begin(), state.Best.end(), line);
+        line[cellCount] = '\n';
+    }
+
+    void AddSummary(GenerateSummary& total, GenerateSummary const& part)
+    {
+        total.Puzzles += part.Puzzles;
+        total.Clues += part.Clues;
+        total.AboveTarget += part.AboveTarget;
+        total.Grids += part.Grids;
+        total.Checks += part.Checks;
+        total.Guesses += part.Guesses;
+    }
+
+    //Puzzles are built a block at a time across the pool and written in order once the block is done
+    template <int BoxSize>
+    GenerateSummary Generate(std::ostream& out, long long count, ThreadPool& pool, GenerateOptions const& options)
+    {
+        const auto lineSize = (size_t)BasicBoard<BoxSize>::CellCount + 1;
+        const auto blockSize = (long long)pool.Size() * 64;
+        std::vector<GeneratorState<BoxSize>> workers(pool.Size());
+        std::vector<char> lines((size_t)blockSize * lineSize);
+        long long first = 0;
+
+        auto generatePuzzle = [&](int worker, size_t index) {
+            GeneratePuzzle((size_t)first + index, &lines[index * lineSize], workers[worker], options);
+        };
+
+        while (first < count)
+        {
+            const auto block = std::min(blockSize, count - first);
+            pool.ParallelFor((size_t)block, generatePuzzle);
+            out.write(lines.data(), (std::streamsize)(block * lineSize));
+            first += block;
+        }
+
+        GenerateSummary summary;
+        for (auto const& state : workers)
+        {
+            AddSummary(summary, state.Summary);
+        }
+        return summary;
+    }
+
+    template GenerateSummary Generate<3>(std::ostream&, long long, ThreadPool&, GenerateOptions const&);
+    template GenerateSummary Generate<4>(std::ostream&, long long, ThreadPool&, GenerateOptions const&);
+    template GenerateSummary Generate<5>(std::ostream&, long long, ThreadPool&, GenerateOptions const&);
+}
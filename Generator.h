@@ -0,0 +1,53 @@
+#pragma once
+#include <ostream>
+
+#include "Board.h"
+
+namespace Solver
+{
+	class ThreadPool;
+
+	//Which cells are removed together, so the clues of a puzzle keep the shape
+	enum class Symmetry
+	{
+		None,
+		//Turning the grid half way round
+		Rotational,
+		//Flipping the grid left to right
+		Mirror,
+		//Flipping the grid across the main diagonal
+		Diagonal
+	};
+
+	//Names are none, rotational, mirror and diagonal
+	bool ParseSymmetry(const char* name, Symmetry& symmetry);
+
+	struct GenerateOptions
+	{
+		//Puzzle i is built from its own random stream, so the same seed gives the same puzzles on any number of threads
+		unsigned long long Seed = 0;
+		Solver::Symmetry Symmetry = Solver::Symmetry::None;
+		//Stop taking clues away once this few are left, zero keeps going until every clue is needed
+		int TargetClues = 0;
+		//Grids to try for a puzzle that can't get down to the target, the one with the fewest clues is kept
+		int Attempts = 20;
+	};
+
+	struct GenerateSummary
+	{
+		long long Puzzles = 0;
+		long long Clues = 0;
+		//Puzzles still above the target clue count after every attempt
+		long long AboveTarget = 0;
+		long long Grids = 0;
+		//Solves run to check a removal leaves a single solution
+		long long Checks = 0;
+		long long Guesses = 0;
+	};
+
+	//Write count puzzles with a single solution each, one per line in the same format batch mode reads
+	//Each puzzle starts from a random full grid filled by the search, then clues are taken away one at a time
+	//in random order, putting back any whose removal lets in a second solution
+	template <int BoxSize = 3>
+	GenerateSummary Generate(std::ostream& out, long long count, ThreadPool& pool, GenerateOptions const& options = GenerateOptions());
+}
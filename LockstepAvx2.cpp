@@ -0,0 +1,39 @@
+#include "LockstepKernels.h"
+
+//Built with AVX2 enabled, and only ever called once the CPU is known to have it
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace Solver
+{
+    namespace
+    {
+        struct Avx2Lanes
+        {
+            using Vector = __m256i;
+
+            static Vector Load(const uint16_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void Store(uint16_t* p, Vector a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+            static Vector Broadcast(uint16_t v) { return _mm256_set1_epi16((short)v); }
+            static Vector And(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+            static Vector Or(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+            static Vector Xor(Vector a, Vector b) { return _mm256_xor_si256(a, b); }
+            //~a & b
+            static Vector AndNot(Vector a, Vector b) { return _mm256_andnot_si256(a, b); }
+            static Vector Decrement(Vector a) { return _mm256_sub_epi16(a, _mm256_set1_epi16(1)); }
+            static Vector IsZero(Vector a) { return _mm256_cmpeq_epi16(a, _mm256_setzero_si256()); }
+            static Vector Equal(Vector a, Vector b) { return _mm256_cmpeq_epi16(a, b); }
+            static bool Any(Vector a) { return _mm256_testz_si256(a, a) == 0; }
+        };
+    }
+
+    template <int Size>
+    void PropagateAvx2(LaneGrid const& grid)
+    {
+        PropagateLanes<Size, Avx2Lanes>(grid);
+    }
+
+    template void PropagateAvx2<9>(LaneGrid const&);
+    template void PropagateAvx2<16>(LaneGrid const&);
+}
+#endif
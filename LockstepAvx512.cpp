@@ -0,0 +1,40 @@
+#include "LockstepKernels.h"
+
+//Built with AVX-512BW enabled, and only ever called once the CPU is known to have it
+#if defined(__AVX512BW__)
+#include <immintrin.h>
+
+namespace Solver
+{
+    namespace
+    {
+        //Comparisons come back as mask registers, spread out to whole lanes so the kernel can treat them like any other vector
+        struct Avx512Lanes
+        {
+            using Vector = __m512i;
+
+            static Vector Load(const uint16_t* p) { return _mm512_loadu_si512(p); }
+            static void Store(uint16_t* p, Vector a) { _mm512_storeu_si512(p, a); }
+            static Vector Broadcast(uint16_t v) { return _mm512_set1_epi16((short)v); }
+            static Vector And(Vector a, Vector b) { return _mm512_and_si512(a, b); }
+            static Vector Or(Vector a, Vector b) { return _mm512_or_si512(a, b); }
+            static Vector Xor(Vector a, Vector b) { return _mm512_xor_si512(a, b); }
+            //~a & b
+            static Vector AndNot(Vector a, Vector b) { return _mm512_andnot_si512(a, b); }
+            static Vector Decrement(Vector a) { return _mm512_sub_epi16(a, _mm512_set1_epi16(1)); }
+            static Vector IsZero(Vector a) { return _mm512_movm_epi16(_mm512_testn_epi16_mask(a, a)); }
+            static Vector Equal(Vector a, Vector b) { return _mm512_movm_epi16(_mm512_cmpeq_epi16_mask(a, b)); }
+            static bool Any(Vector a) { return _mm512_test_epi16_mask(a, a) != 0; }
+        };
+    }
+
+    template <int Size>
+    void PropagateAvx512(LaneGrid const& grid)
+    {
+        PropagateLanes<Size, Avx512Lanes>(grid);
+    }
+
+    template void PropagateAvx512<9>(LaneGrid const&);
+    template void PropagateAvx512<16>(LaneGrid const&);
+}
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+#include <stdint.h>
+
+//The propagation kernels of the lockstep solver, one per instruction set
+//Each is built in its own file with the compiler flags for its instruction set, and the solver picks one at run time
+//Those files can only include this header and the intrinsics, anything inline from elsewhere could be compiled
+//with instructions the CPU running it doesn't have and then shared with the rest of the program by the linker
+namespace Solver
+{
+	//The most lanes any kernel has, enough for AVX-512
+	const int MaxLockstepLanes = 32;
+
+	//The lanes of a lockstep solver as the kernels see them
+	struct LaneGrid
+	{
+		//Cells in row order, each with a mask per lane
+		uint16_t (*Cells)[MaxLockstepLanes];
+		//Size cells for each unit, rows then columns then boxes
+		const unsigned char* UnitCells;
+		//Set in each lane left with an open cell, and in each lane that hit a contradiction
+		uint16_t* Open;
+		uint16_t* Contradiction;
+	};
+
+	//Size is 9 or 16, the kernels are built for both
+	template <int Size>
+	void PropagatePlain(LaneGrid const& grid);
+	template <int Size>
+	void PropagateSse2(LaneGrid const& grid);
+	template <int Size>
+	void PropagateAvx2(LaneGrid const& grid);
+	template <int Size>
+	void PropagateAvx512(LaneGrid const& grid);
+
+	//The mask where it has exactly one bit set and zero elsewhere
+	template <typename Ops>
+	inline typename Ops::Vector Singles(typename Ops::Vector m)
+	{
+		return Ops::And(Ops::IsZero(Ops::And(m, Ops::Decrement(m))), m);
+	}
+
+	//Each round works through the units in turn, and within a unit
+	// - takes the value of every solved cell out of the others, a value solved twice clears both cells
+	// - places any value left with one cell, that cell keeps only the value
+	//Changes made for one unit are seen by the next, so a round often gets through several steps of the queue
+	//the scalar solver would work through. Lanes that are already done just see no change.
+	//Ops holds the vector type and its operations, comparisons give all ones in a lane where they hold and zero where they don't
+	template <int Size, typename Ops>
+	void PropagateLanes(LaneGrid const& grid)
+	{
+		using Vector = typename Ops::Vector;
+		const auto all = Ops::Broadcast((uint16_t)((1u << Size) - 1));
+		const auto ones = Ops::Broadcast(0xFFFF);
+		auto contradiction = Ops::Broadcast(0);
+		Vector cells[Size];
+
+		for (;;)
+		{
+			auto changed = Ops::Broadcast(0);
+			for (auto unit = 0; unit < 3 * Size; ++unit)
+			{
+				const auto unitCells = grid.UnitCells + unit * Size;
+
+				auto solved = Ops::Broadcast(0);
+				auto solvedTwice = Ops::Broadcast(0);
+				for (auto i = 0; i < Size; ++i)
+				{
+					cells[i] = Ops::Load(grid.Cells[unitCells[i]]);
+					const auto single = Singles<Ops>(cells[i]);
+					solvedTwice = Ops::Or(solvedTwice, Ops::And(solved, single));
+					solved = Ops::Or(solved, single);
+				}
+
+				auto seen = Ops::Broadcast(0);
+				auto seenTwice = Ops::Broadcast(0);
+				for (auto i = 0; i < Size; ++i)
+				{
+					const auto single = Singles<Ops>(cells[i]);
+					cells[i] = Ops::AndNot(Ops::Or(Ops::AndNot(single, solved), solvedTwice), cells[i]);
+					seenTwice = Ops::Or(seenTwice, Ops::And(seen, cells[i]));
+					seen = Ops::Or(seen, cells[i]);
+				}
+				contradiction = Ops::Or(contradiction, Ops::Xor(Ops::Equal(seen, all), ones));
+
+				const auto hidden = Ops::AndNot(seenTwice, seen);
+				for (auto i = 0; i < Size; ++i)
+				{
+					const auto place = Ops::And(cells[i], hidden);
+					const auto next = Ops::Or(Ops::And(cells[i], Ops::IsZero(place)), place);
+					const auto cell = grid.Cells[unitCells[i]];
+					changed = Ops::Or(changed, Ops::Xor(next, Ops::Load(cell)));
+					contradiction = Ops::Or(contradiction, Ops::IsZero(next));
+					Ops::Store(cell, next);
+				}
+			}
+			if (!Ops::Any(changed)) { break; }
+		}
+
+		auto open = Ops::Broadcast(0);
+		for (auto cell = 0; cell < Size * Size; ++cell)
+		{
+			const auto m = Ops::Load(grid.Cells[cell]);
+			open = Ops::Or(open, Ops::Xor(Ops::IsZero(Ops::And(m, Ops::Decrement(m))), ones));
+		}
+		Ops::Store(grid.Open, open);
+		Ops::Store(grid.Contradiction, contradiction);
+	}
+}
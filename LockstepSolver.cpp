@@ -0,0 +1,221 @@
+#include "LockstepSolver.h"
+
+#include <string.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace Solver
+{
+    //Plain loops over 8 lanes, the compiler is free to vectorize them itself
+    struct PlainLanes
+    {
+        struct Vector
+        {
+            uint16_t Lane[8];
+        };
+
+        template <typename Op>
+        static Vector Apply(Vector a, Vector b, Op op)
+        {
+            Vector result;
+            for (auto i = 0; i < 8; ++i) { result.Lane[i] = (uint16_t)op(a.Lane[i], b.Lane[i]); }
+            return result;
+        }
+
+        static Vector Load(const uint16_t* p) { Vector a; memcpy(a.Lane, p, sizeof(a.Lane)); return a; }
+        static void Store(uint16_t* p, Vector a) { memcpy(p, a.Lane, sizeof(a.Lane)); }
+        static Vector Broadcast(uint16_t v) { Vector a; for (auto& lane : a.Lane) { lane = v; } return a; }
+        static Vector And(Vector a, Vector b) { return Apply(a, b, [](uint16_t x, uint16_t y) { return x & y; }); }
+        static Vector Or(Vector a, Vector b) { return Apply(a, b, [](uint16_t x, uint16_t y) { return x | y; }); }
+        static Vector Xor(Vector a, Vector b) { return Apply(a, b, [](uint16_t x, uint16_t y) { return x ^ y; }); }
+        //~a & b
+        static Vector AndNot(Vector a, Vector b) { return Apply(a, b, [](uint16_t x, uint16_t y) { return ~x & y; }); }
+        static Vector Decrement(Vector a) { return Apply(a, a, [](uint16_t x, uint16_t) { return x - 1; }); }
+        static Vector IsZero(Vector a) { return Apply(a, a, [](uint16_t x, uint16_t) { return x == 0 ? 0xFFFF : 0; }); }
+        static Vector Equal(Vector a, Vector b) { return Apply(a, b, [](uint16_t x, uint16_t y) { return x == y ? 0xFFFF : 0; }); }
+        static bool Any(Vector a)
+        {
+            auto bits = 0;
+            for (auto lane : a.Lane) { bits |= lane; }
+            return bits != 0;
+        }
+    };
+
+    template <int Size>
+    void PropagatePlain(LaneGrid const& grid)
+    {
+        PropagateLanes<Size, PlainLanes>(grid);
+    }
+
+    //The x86 kernels are only built when CMake gives their files the flags they need
+#if SUDOKU_X86_KERNELS
+#if defined(_MSC_VER)
+    //Leaf 7 for AVX2 and AVX-512, and the OS has to save the wider registers on a context switch as well
+    bool CpuHas(LockstepKernel kernel)
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) { return kernel == LockstepKernel::Sse2; }
+        __cpuid(info, 1);
+        const auto osSaves = (info[2] & (1 << 27)) != 0;
+        const auto state = osSaves ? _xgetbv(0) : 0;
+        __cpuidex(info, 7, 0);
+        switch (kernel)
+        {
+        case LockstepKernel::Sse2: return true;
+        case LockstepKernel::Avx2: return (state & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+        case LockstepKernel::Avx512: return (state & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0;
+        default: return false;
+        }
+    }
+#else
+    //The compiler's own checks include whether the OS saves the wider registers
+    bool CpuHas(LockstepKernel kernel)
+    {
+        switch (kernel)
+        {
+        case LockstepKernel::Sse2: return __builtin_cpu_supports("sse2") != 0;
+        case LockstepKernel::Avx2: return __builtin_cpu_supports("avx2") != 0;
+        case LockstepKernel::Avx512: return __builtin_cpu_supports("avx512f") != 0 && __builtin_cpu_supports("avx512bw") != 0;
+        default: return false;
+        }
+    }
+#endif
+#else
+    bool CpuHas(LockstepKernel)
+    {
+        return false;
+    }
+#endif
+
+    LockstepKernel DetectLockstepKernel()
+    {
+        static const auto kernel = CpuHas(LockstepKernel::Avx512) ? LockstepKernel::Avx512
+            : CpuHas(LockstepKernel::Avx2) ? LockstepKernel::Avx2
+            : CpuHas(LockstepKernel::Sse2) ? LockstepKernel::Sse2
+            : LockstepKernel::Plain;
+        return kernel;
+    }
+
+    bool LockstepKernelSupported(LockstepKernel kernel)
+    {
+        return kernel == LockstepKernel::Plain || CpuHas(kernel);
+    }
+
+    int LockstepLanes(LockstepKernel kernel)
+    {
+        switch (kernel)
+        {
+        case LockstepKernel::Avx512: return 32;
+        case LockstepKernel::Avx2: return 16;
+        case LockstepKernel::Sse2:
+        case LockstepKernel::Plain:
+        default: return 8;
+        }
+    }
+
+    const char* GetLockstepKernelName(LockstepKernel kernel)
+    {
+        switch (kernel)
+        {
+        case LockstepKernel::Avx512: return "avx512";
+        case LockstepKernel::Avx2: return "avx2";
+        case LockstepKernel::Sse2: return "sse2";
+        case LockstepKernel::Plain:
+        default: return "plain";
+        }
+    }
+
+    template <int Size>
+    auto GetPropagate(LockstepKernel kernel) -> void (*)(LaneGrid const&)
+    {
+        switch (kernel)
+        {
+#if SUDOKU_X86_KERNELS
+        case LockstepKernel::Avx512: return &PropagateAvx512<Size>;
+        case LockstepKernel::Avx2: return &PropagateAvx2<Size>;
+        case LockstepKernel::Sse2: return &PropagateSse2<Size>;
+#endif
+        case LockstepKernel::Plain:
+        default: return &PropagatePlain<Size>;
+        }
+    }
+
+    template <int BoxSize>
+    BasicLockstepSolver<BoxSize>::BasicLockstepSolver(LockstepKernel kernel)
+        : m_kernel(kernel)
+        , m_propagate(GetPropagate<Size>(kernel))
+    {
+        static_assert(sizeof(typename BasicBoard<BoxSize>::CellIndex) == 1, "The kernels take cell indexes as bytes");
+        Clear();
+    }
+
+    template <int BoxSize>
+    int BasicLockstepSolver<BoxSize>::Lanes() const
+    {
+        return LockstepLanes(m_kernel);
+    }
+
+    template <int BoxSize>
+    void BasicLockstepSolver<BoxSize>::Clear()
+    {
+        const auto all = (uint16_t)((1u << Size) - 1);
+        for (auto& cell : m_cells)
+        {
+            for (auto& lane : cell) { lane = all; }
+        }
+        memset(m_open, 0, sizeof(m_open));
+        memset(m_contradiction, 0, sizeof(m_contradiction));
+    }
+
+    template <int BoxSize>
+    bool BasicLockstepSolver<BoxSize>::Load(int lane, const char* line)
+    {
+        const auto all = (uint16_t)((1u << Size) - 1);
+        for (auto cell = 0; cell < CellCount; ++cell)
+        {
+            const auto c = line[cell];
+            const auto v = CharValue(c);
+            if (v >= 1 && v <= Size) { m_cells[cell][lane] = (uint16_t)(1u << (v - 1)); }
+            else if (c == '.' || c == '0') { m_cells[cell][lane] = all; }
+            else { return false; }
+        }
+        return true;
+    }
+
+    template <int BoxSize>
+    void BasicLockstepSolver<BoxSize>::Propagate()
+    {
+        LaneGrid grid;
+        grid.Cells = m_cells;
+        grid.UnitCells = BasicBoard<BoxSize>::GetUnitCells(0);
+        grid.Open = m_open;
+        grid.Contradiction = m_contradiction;
+        m_propagate(grid);
+    }
+
+    template <int BoxSize>
+    LaneStatus BasicLockstepSolver<BoxSize>::Status(int lane) const
+    {
+        if (m_contradiction[lane]) { return LaneStatus::Contradiction; }
+        return m_open[lane] ? LaneStatus::Open : LaneStatus::Solved;
+    }
+
+    template <int BoxSize>
+    void BasicLockstepSolver<BoxSize>::ToLine(int lane, char* line) const
+    {
+        for (auto cell = 0; cell < CellCount; ++cell)
+        {
+            const auto m = m_cells[cell][lane];
+            line[cell] = (m != 0 && (m & (m - 1)) == 0) ? ValueChar((int)LowestBit(m) + 1) : '.';
+        }
+    }
+
+    template void PropagatePlain<9>(LaneGrid const&);
+    template void PropagatePlain<16>(LaneGrid const&);
+    template class BasicLockstepSolver<3>;
+    template class BasicLockstepSolver<4>;
+}
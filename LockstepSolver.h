@@ -0,0 +1,85 @@
+#pragma once
+#include <stdint.h>
+
+#include "Board.h"
+#include "LockstepKernels.h"
+
+//Set to 0 to have batch mode solve every puzzle on its own, the CMake option SUDOKU_LOCKSTEP does this
+//Only on by default on x86, where there are vector kernels, the plain loops used elsewhere are slower than solving one at a time
+#ifndef SUDOKU_LOCKSTEP
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SUDOKU_LOCKSTEP 1
+#else
+#define SUDOKU_LOCKSTEP 0
+#endif
+#endif
+
+namespace Solver
+{
+	//Instruction sets the lockstep solver has a kernel for, narrowest first
+	enum class LockstepKernel
+	{
+		//Plain loops over 8 lanes, for CPUs without any of the others
+		Plain,
+		Sse2,
+		Avx2,
+		Avx512
+	};
+
+	//The widest kernel this CPU can run, worked out once from what the CPU reports
+	LockstepKernel DetectLockstepKernel();
+	bool LockstepKernelSupported(LockstepKernel kernel);
+	//Puzzles per vector register, 8 for SSE2 and the plain loops, 16 for AVX2 and 32 for AVX-512BW
+	int LockstepLanes(LockstepKernel kernel);
+	//plain, sse2, avx2 or avx512
+	const char* GetLockstepKernelName(LockstepKernel kernel);
+
+	//Where a lane ended up once nothing more could be placed
+	enum class LaneStatus
+	{
+		Solved,
+		//Stuck with some cells still open, the search has to guess from here
+		Open,
+		//A cell ran out of candidates or a unit lost a digit, the puzzle has no solution or its givens clash
+		Contradiction
+	};
+
+	//Places singles and hidden singles on a batch of puzzles at once, one puzzle per lane of a vector register
+	//Candidates are stored as structure of arrays, each cell holding one mask per lane, so every step of the
+	//propagation runs on all the lanes with the same instructions and no lane ever branches on its own
+	//Easy puzzles come out solved, the rest are handed back for the scalar search
+	//Lanes are 16 bits, so this is for 9x9 and 16x16 grids only
+	template <int BoxSize>
+	class BasicLockstepSolver
+	{
+	public:
+		static const int Size = BasicBoard<BoxSize>::Size;
+		static const int CellCount = BasicBoard<BoxSize>::CellCount;
+		static_assert(Size <= 16, "Lanes hold 16 bit masks");
+
+		//The kernel has to be one LockstepKernelSupported says this CPU can run
+		explicit BasicLockstepSolver(LockstepKernel kernel = DetectLockstepKernel());
+
+		int Lanes() const;
+		//Empty every lane, a lane left empty is never solved and costs nothing extra
+		void Clear();
+		//Put a puzzle of CellCount characters in a lane, returns false for a character that isn't a value or a blank
+		bool Load(int lane, const char* line);
+		//Run every lane until no lane changes
+		void Propagate();
+
+		LaneStatus Status(int lane) const;
+		//The lane as CellCount characters, with the cells placed so far and blanks for the rest
+		void ToLine(int lane, char* line) const;
+
+	private:
+		LockstepKernel m_kernel;
+		void (*m_propagate)(LaneGrid const& grid);
+		//Cells in row order, each with a mask per lane
+		uint16_t m_cells[CellCount][MaxLockstepLanes];
+		uint16_t m_open[MaxLockstepLanes];
+		uint16_t m_contradiction[MaxLockstepLanes];
+	};
+
+	using LockstepSolver = BasicLockstepSolver<3>;
+}
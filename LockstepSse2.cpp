@@ -0,0 +1,39 @@
+#include "LockstepKernels.h"
+
+//SSE2 is part of every x86-64 CPU, so this is the kernel to fall back on there
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+
+namespace Solver
+{
+    namespace
+    {
+        struct Sse2Lanes
+        {
+            using Vector = __m128i;
+
+            static Vector Load(const uint16_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void Store(uint16_t* p, Vector a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+            static Vector Broadcast(uint16_t v) { return _mm_set1_epi16((short)v); }
+            static Vector And(Vector a, Vector b) { return _mm_and_si128(a, b); }
+            static Vector Or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+            static Vector Xor(Vector a, Vector b) { return _mm_xor_si128(a, b); }
+            //~a & b
+            static Vector AndNot(Vector a, Vector b) { return _mm_andnot_si128(a, b); }
+            static Vector Decrement(Vector a) { return _mm_sub_epi16(a, _mm_set1_epi16(1)); }
+            static Vector IsZero(Vector a) { return _mm_cmpeq_epi16(a, _mm_setzero_si128()); }
+            static Vector Equal(Vector a, Vector b) { return _mm_cmpeq_epi16(a, b); }
+            static bool Any(Vector a) { return _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128())) != 0xFFFF; }
+        };
+    }
+
+    template <int Size>
+    void PropagateSse2(LaneGrid const& grid)
+    {
+        PropagateLanes<Size, Sse2Lanes>(grid);
+    }
+
+    template void PropagateSse2<9>(LaneGrid const&);
+    template void PropagateSse2<16>(LaneGrid const&);
+}
+#endif
@@ -0,0 +1,191 @@
+#include "ParallelSolver.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace Solver
+{
+    //Work shared between the workers of one parallel solve
+    //Each piece of work is a set up board whose whole subtree still needs searching
+    template <int BoxSize>
+    class SharedSearch
+    {
+    public:
+        using Board = BasicBoard<BoxSize>;
+        using MoveStack = BasicMoveStack<BoxSize>;
+
+        SharedSearch(Board const& root, BasicSolveOptions<BoxSize> const& options, SolveBudget const& budget)
+            : m_options(options)
+            , m_budget(budget)
+            , m_work{ root }
+            , m_active(0)
+            , m_stopStatus(SolveStatus::Cancelled)
+            , m_requests(0)
+            , m_solved(false)
+            , m_stopped(false)
+            , m_guesses(0)
+            , m_started(0)
+        {
+        }
+
+        //Keep taking work until the puzzle is solved or every subtree is exhausted
+        void Run()
+        {
+            MoveStack boardStack;
+            Monitor monitor(*this);
+            auto board = Board();
+
+            while (Take(board))
+            {
+                boardStack.Reset(board);
+
+                auto guesses = 0;
+                const auto status = Search<BoxSize>(boardStack, guesses, m_options, nullptr, &monitor);
+                m_guesses += guesses;
+
+                Finish(status == SolveStatus::Solved ? &boardStack.Top().Board : nullptr);
+            }
+        }
+
+        bool IsSolved() const { return m_solved.load(); }
+        //Whether the budget ran out or was cancelled first, and what the solve then ends with
+        bool IsStopped() const { return m_stopped.load(); }
+        SolveStatus StopStatus() const { return m_stopStatus; }
+        Board const& Solution() const { return m_solution; }
+        int Guesses() const { return m_guesses.load(); }
+
+    private:
+        //Checked before every guess, so everything on the fast path is a relaxed load
+        //Each worker checks its own copy of the budget against the guesses of them all
+        class Monitor : public BasicSearchMonitor<BoxSize>
+        {
+        public:
+            explicit Monitor(SharedSearch& search) : m_search(search), m_budget(search.m_budget) {}
+
+            bool Continue(MoveStack& boardStack) override
+            {
+                if (m_search.m_solved.load(std::memory_order_relaxed) || m_search.m_stopped.load(std::memory_order_relaxed)) { return false; }
+                if (m_budget.Limited() && !m_budget.Continue(m_search.m_started.fetch_add(1, std::memory_order_relaxed)))
+                {
+                    m_search.Stop(m_budget.Stopped());
+                    return false;
+                }
+                if (m_search.m_requests.load(std::memory_order_relaxed) > 0 && boardStack.Size() >= 2)
+                {
+                    m_search.Donate(boardStack);
+                }
+                return true;
+            }
+
+        private:
+            SharedSearch& m_search;
+            SolveBudget m_budget;
+        };
+
+        //Wait for work, returns false once the search is over
+        bool Take(Board& board)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_work.empty() && m_active > 0 && !m_solved && !m_stopped)
+            {
+                m_requests += 1;
+                m_changed.wait(lock, [this] { return !m_work.empty() || m_active == 0 || m_solved || m_stopped; });
+            }
+            if (m_solved || m_stopped || m_work.empty()) { return false; }
+
+            board = m_work.front();
+            m_work.pop_front();
+            m_active += 1;
+            return true;
+        }
+
+        //Done with a subtree, either with a solution or with nothing left in it
+        void Finish(Board const* solution)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_active -= 1;
+            if (solution && !m_solved)
+            {
+                m_solution = *solution;
+                m_solved = true;
+            }
+            if (m_solved || m_stopped || (m_active == 0 && m_work.empty())) { m_changed.notify_all(); }
+        }
+
+        //Ends the search for every worker, unless it was already solved
+        void Stop(SolveStatus status)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_solved || m_stopped) { return; }
+            m_stopStatus = status;
+            m_stopped = true;
+            m_changed.notify_all();
+        }
+
+        //Hand over the untried guesses of the bottom board, which is the biggest piece of work left
+        //The bottom board is dropped so this worker only finishes the subtree it is in
+        void Donate(MoveStack& boardStack)
+        {
+            auto requests = m_requests.load();
+            if (requests <= 0 || !m_requests.compare_exchange_strong(requests, requests - 1)) { return; }
+
+            auto board = boardStack[0].Board;
+            board.ClearGuess(boardStack[1].Guess);
+            boardStack.DropBottom();
+            //Nothing left to give at this level, leave the request for the next one down
+            if (!board.IsValid())
+            {
+                m_requests += 1;
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_work.push_back(board);
+            m_changed.notify_one();
+        }
+
+        BasicSolveOptions<BoxSize> m_options;
+        SolveBudget m_budget;
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+        std::deque<Board> m_work;
+        int m_active;
+        SolveStatus m_stopStatus;
+
+        std::atomic<int> m_requests;
+        std::atomic<bool> m_solved;
+        std::atomic<bool> m_stopped;
+        std::atomic<int> m_guesses;
+        //Guesses every worker has started, which the budget counts
+        std::atomic<int> m_started;
+        Board m_solution;
+    };
+
+    template <int BoxSize>
+    SolveStatus SolveParallel(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& guesses, ThreadPool& pool,
+        BasicSolveOptions<BoxSize> const& options)
+    {
+        guesses = 0;
+        const auto budget = StartBudget(options);
+
+        auto root = board;
+        if (!root.SetInitialData()) { return SolveStatus::InvalidInput; }
+        if (!root.SolveKnown()) { return SolveStatus::Unsolvable; }
+
+        SharedSearch<BoxSize> search(root, options, budget);
+        pool.ParallelFor(pool.Size(), [&](int, size_t) { search.Run(); });
+
+        guesses = search.Guesses();
+        if (!search.IsSolved()) { return search.IsStopped() ? search.StopStatus() : SolveStatus::Unsolvable; }
+
+        solution = search.Solution();
+        return SolveStatus::Solved;
+    }
+
+    template SolveStatus SolveParallel<3>(BasicBoard<3> const&, BasicBoard<3>&, int&, ThreadPool&, BasicSolveOptions<3> const&);
+    template SolveStatus SolveParallel<4>(BasicBoard<4> const&, BasicBoard<4>&, int&, ThreadPool&, BasicSolveOptions<4> const&);
+    template SolveStatus SolveParallel<5>(BasicBoard<5> const&, BasicBoard<5>&, int&, ThreadPool&, BasicSolveOptions<5> const&);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "Board.h"
+
+namespace Solver
+{
+	class ThreadPool;
+
+	//Splits the guess tree of a single puzzle across every worker in the pool
+	//Idle workers ask for work and busy ones hand over the untried guesses at the bottom of their stack
+	//The first solution found stops every worker, as does running out of the budgets in the options, counted over all of them
+	template <int BoxSize>
+	SolveStatus SolveParallel(BasicBoard<BoxSize> const& board, BasicBoard<BoxSize>& solution, int& guesses, ThreadPool& pool,
+		BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>());
+}
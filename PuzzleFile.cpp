@@ -0,0 +1,238 @@
+#include "PuzzleFile.h"
+#include "FileIo.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace Solver
+{
+    void WriteLittleEndian(uint64_t value, int bytes, char* out)
+    {
+        for (auto i = 0; i < bytes; ++i)
+        {
+            out[i] = (char)(value >> (8 * i));
+        }
+    }
+
+    uint64_t ReadLittleEndian(const char* data, int bytes)
+    {
+        uint64_t value = 0;
+        for (auto i = 0; i < bytes; ++i)
+        {
+            value |= (uint64_t)(unsigned char)data[i] << (8 * i);
+        }
+        return value;
+    }
+
+    template <int BoxSize>
+    BinaryHeader MakeBinaryHeader(bool hasSolutions)
+    {
+        BinaryHeader header;
+        header.BoxSize = BoxSize;
+        header.HasSolutions = hasSolutions;
+        header.RecordSize = BinaryFormat<BoxSize>::RecordSize;
+        return header;
+    }
+
+    void WriteBinaryHeader(BinaryHeader const& header, char* out)
+    {
+        memset(out, 0, BinaryHeader::Size);
+        memcpy(out, "SDKB", 4);
+        WriteLittleEndian(BinaryHeader::Version, 2, out + 4);
+        out[6] = (char)header.BoxSize;
+        out[7] = (char)(header.HasSolutions ? 1 : 0);
+        WriteLittleEndian(header.RecordSize, 4, out + 8);
+        WriteLittleEndian(BinaryHeader::Size, 4, out + 12);
+        WriteLittleEndian(header.RecordCount, 8, out + 16);
+    }
+
+    bool ReadBinaryHeader(const char* data, size_t size, BinaryHeader& header)
+    {
+        if (size < BinaryHeader::Size || memcmp(data, "SDKB", 4) != 0) { return false; }
+        if (ReadLittleEndian(data + 4, 2) != BinaryHeader::Version) { return false; }
+
+        header.BoxSize = (unsigned char)data[6];
+        header.HasSolutions = (data[7] & 1) != 0;
+        header.RecordSize = (size_t)ReadLittleEndian(data + 8, 4);
+        const auto headerSize = (size_t)ReadLittleEndian(data + 12, 4);
+        if (header.RecordSize == 0 || headerSize < BinaryHeader::Size || headerSize > size) { return false; }
+
+        //A file cut short, or never finished, still has every whole record it got to
+        header.DataOffset = headerSize;
+        const auto records = (uint64_t)((size - headerSize) / header.RecordSize);
+        const auto count = ReadLittleEndian(data + 16, 8);
+        header.RecordCount = count < records ? count : records;
+        return true;
+    }
+
+    bool FinishBinaryFile(FILE* file, BinaryHeader header, uint64_t count)
+    {
+        char bytes[BinaryHeader::Size];
+        header.RecordCount = count;
+        WriteBinaryHeader(header, bytes);
+        if (fflush(file) != 0 || fseek(file, 0, SEEK_SET) != 0) { return false; }
+        const auto written = fwrite(bytes, 1, sizeof(bytes), file) == sizeof(bytes);
+        return fseek(file, 0, SEEK_END) == 0 && written;
+    }
+
+    //The characters FromLine takes for a cell, a value up to Size or a blank
+    template <int BoxSize>
+    bool IsPuzzleLine(const char* line)
+    {
+        for (auto cell = 0; cell < BasicBoard<BoxSize>::CellCount; ++cell)
+        {
+            const auto v = CharValue(line[cell]);
+            if ((v < 1 || v > BasicBoard<BoxSize>::Size) && line[cell] != '.' && line[cell] != '0') { return false; }
+        }
+        return true;
+    }
+
+    template <int BoxSize>
+    void PackRecord(const char* puzzle, const char* solution, RecordStatus status, char* record)
+    {
+        using Format = BinaryFormat<BoxSize>;
+        const auto size = BasicBoard<BoxSize>::Size;
+        memset(record, 0, Format::RecordSize);
+        record[0] = (char)(IsPuzzleLine<BoxSize>(puzzle) ? status : RecordStatus::Invalid);
+
+        auto bitmap = reinterpret_cast<unsigned char*>(record + 1);
+        auto grid = bitmap + Format::BitmapSize;
+        for (auto cell = 0; cell < Format::CellCount; ++cell)
+        {
+            auto v = CharValue(puzzle[cell]);
+            if (v > size) { v = 0; }
+            if (v != 0) { bitmap[cell / 8] |= (unsigned char)(1 << (cell % 8)); }
+            if (solution != nullptr)
+            {
+                v = CharValue(solution[cell]);
+                if (v > size) { v = 0; }
+            }
+
+            //A digit can straddle two bytes but never three
+            const auto bit = cell * Format::DigitBits;
+            const auto bits = (unsigned int)v << (bit % 8);
+            grid[bit / 8] |= (unsigned char)bits;
+            if (bits >> 8) { grid[bit / 8 + 1] |= (unsigned char)(bits >> 8); }
+        }
+    }
+
+    template <int BoxSize>
+    RecordStatus UnpackRecord(const char* record, bool hasSolutions, char* puzzle, char* solution)
+    {
+        using Format = BinaryFormat<BoxSize>;
+        auto bitmap = reinterpret_cast<const unsigned char*>(record + 1);
+        auto grid = bitmap + Format::BitmapSize;
+        const auto mask = (1u << Format::DigitBits) - 1;
+        for (auto cell = 0; cell < Format::CellCount; ++cell)
+        {
+            const auto bit = cell * Format::DigitBits;
+            auto bits = (unsigned int)grid[bit / 8];
+            if ((bit % 8) + Format::DigitBits > 8) { bits |= (unsigned int)grid[bit / 8 + 1] << 8; }
+            const auto v = (int)((bits >> (bit % 8)) & mask);
+
+            const auto given = (bitmap[cell / 8] >> (cell % 8)) & 1;
+            if (puzzle != nullptr) { puzzle[cell] = given && v != 0 ? ValueChar(v) : '.'; }
+            if (solution != nullptr && hasSolutions) { solution[cell] = v != 0 ? ValueChar(v) : '.'; }
+        }
+        return (RecordStatus)record[0];
+    }
+
+    template <int BoxSize>
+    long long TextToBinary(const char* data, size_t size, BufferedWriter& out, BinaryHeader& header)
+    {
+        using Format = BinaryFormat<BoxSize>;
+        const auto cellCount = (size_t)Format::CellCount;
+        const auto end = data + size;
+        LineRef first;
+
+        //Peek at the first line to see whether this is an archive of solutions
+        auto position = data;
+        const auto hasSolutions = NextLine(position, end, first) && first.Length >= 2 * cellCount + 1;
+        header = MakeBinaryHeader<BoxSize>(hasSolutions);
+        WriteBinaryHeader(header, out.Reserve(BinaryHeader::Size));
+        out.Commit(BinaryHeader::Size);
+
+        long long count = 0;
+        position = data;
+        LineRef next;
+        while (NextLine(position, end, next))
+        {
+            auto line = next.Data;
+            const auto length = next.Length;
+            auto status = RecordStatus::Puzzle;
+            const char* solution = nullptr;
+            if (length < cellCount || !IsPuzzleLine<BoxSize>(line)) { status = RecordStatus::Invalid; }
+            else if (hasSolutions && length >= 2 * cellCount + 1)
+            {
+                solution = line + cellCount + 1;
+                status = RecordStatus::Solved;
+            }
+            else if (hasSolutions && length > cellCount + 1)
+            {
+                //Batch output for a puzzle it couldn't solve
+                const auto unsolvable = length - cellCount - 1 == 10 && memcmp(line + cellCount + 1, "unsolvable", 10) == 0;
+                status = unsolvable ? RecordStatus::Unsolvable : RecordStatus::Invalid;
+            }
+
+            char padded[Format::CellCount];
+            if (length < cellCount)
+            {
+                memset(padded, '.', sizeof(padded));
+                line = padded;
+            }
+            PackRecord<BoxSize>(line, solution, status, out.Reserve(Format::RecordSize));
+            out.Commit(Format::RecordSize);
+            count += 1;
+        }
+        return count;
+    }
+
+    template <int BoxSize>
+    long long BinaryToText(const char* data, size_t size, BufferedWriter& out)
+    {
+        using Format = BinaryFormat<BoxSize>;
+        static const char* const StatusWords[] = { "", "", "unsolvable", "invalid" };
+        BinaryHeader header;
+        if (!ReadBinaryHeader(data, size, header) || header.BoxSize != BoxSize || header.RecordSize != Format::RecordSize) { return -1; }
+
+        const auto records = data + header.DataOffset;
+        for (uint64_t i = 0; i < header.RecordCount; ++i)
+        {
+            //Room for the puzzle, a space, the solution or a status word, and the newline
+            auto line = out.Reserve(2 * Format::CellCount + 2);
+            const auto status = UnpackRecord<BoxSize>(records + i * Format::RecordSize, header.HasSolutions, line, line + Format::CellCount + 1);
+            auto length = (size_t)Format::CellCount;
+            if (header.HasSolutions && status == RecordStatus::Solved)
+            {
+                line[length] = ' ';
+                length += 1 + Format::CellCount;
+            }
+            else if (header.HasSolutions && (status == RecordStatus::Unsolvable || status == RecordStatus::Invalid))
+            {
+                const auto word = StatusWords[(int)status];
+                line[length] = ' ';
+                memcpy(line + length + 1, word, strlen(word));
+                length += 1 + strlen(word);
+            }
+            line[length] = '\n';
+            out.Commit(length + 1);
+        }
+        return (long long)header.RecordCount;
+    }
+
+    template BinaryHeader MakeBinaryHeader<3>(bool);
+    template BinaryHeader MakeBinaryHeader<4>(bool);
+    template BinaryHeader MakeBinaryHeader<5>(bool);
+    template void PackRecord<3>(const char*, const char*, RecordStatus, char*);
+    template void PackRecord<4>(const char*, const char*, RecordStatus, char*);
+    template void PackRecord<5>(const char*, const char*, RecordStatus, char*);
+    template RecordStatus UnpackRecord<3>(const char*, bool, char*, char*);
+    template RecordStatus UnpackRecord<4>(const char*, bool, char*, char*);
+    template RecordStatus UnpackRecord<5>(const char*, bool, char*, char*);
+    template long long TextToBinary<3>(const char*, size_t, BufferedWriter&, BinaryHeader&);
+    template long long TextToBinary<4>(const char*, size_t, BufferedWriter&, BinaryHeader&);
+    template long long TextToBinary<5>(const char*, size_t, BufferedWriter&, BinaryHeader&);
+    template long long BinaryToText<3>(const char*, size_t, BufferedWriter&);
+    template long long BinaryToText<4>(const char*, size_t, BufferedWriter&);
+    template long long BinaryToText<5>(const char*, size_t, BufferedWriter&);
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Board.h"
+
+namespace Solver
+{
+	class BufferedWriter;
+
+	//Packed binary puzzle files, for archives where 82 bytes of text per puzzle adds up
+	//A 32 byte header is followed by fixed-size records, so record i always starts at HeaderSize + i * RecordSize
+	//and any record can be read without an index or a scan
+	//Header, all numbers little-endian:
+	// 0  "SDKB"
+	// 4  version, 16 bits
+	// 6  box size, 8 bits
+	// 7  flags, bit 0 set when records hold solutions
+	// 8  record size, 32 bits
+	// 12 header size, 32 bits
+	// 16 record count, 64 bits, all ones while a file is still being written
+	// 24 reserved
+	//Record:
+	// status byte, a RecordStatus
+	// givens bitmap, bit i set when cell i is given
+	// every cell packed into DigitBits bits, low bits first, holding the solution if there is one and the givens otherwise
+	enum class RecordStatus : unsigned char
+	{
+		Puzzle,
+		Solved,
+		Unsolvable,
+		Invalid
+	};
+
+	struct BinaryHeader
+	{
+		static const size_t Size = 32;
+		static const unsigned int Version = 1;
+		static const uint64_t UnknownCount = ~(uint64_t)0;
+
+		int BoxSize = 3;
+		bool HasSolutions = false;
+		size_t RecordSize = 0;
+		uint64_t RecordCount = UnknownCount;
+		//Where the first record starts, a later version may have a longer header
+		size_t DataOffset = Size;
+	};
+
+	template <int BoxSize>
+	struct BinaryFormat
+	{
+		static const int CellCount = BasicBoard<BoxSize>::CellCount;
+		//Enough bits for every value and zero for a blank
+		static const int DigitBits = BasicBoard<BoxSize>::Size < 16 ? 4 : 5;
+		static const size_t BitmapSize = (CellCount + 7) / 8;
+		static const size_t GridSize = (CellCount * DigitBits + 7) / 8;
+		static const size_t RecordSize = 1 + BitmapSize + GridSize;
+	};
+
+	//Header for a file of BoxSize records, with the count left unknown until the file is finished
+	template <int BoxSize>
+	BinaryHeader MakeBinaryHeader(bool hasSolutions);
+	void WriteBinaryHeader(BinaryHeader const& header, char* out);
+	//Returns false if the data doesn't start with a header this version understands
+	//The record count is worked out from the size when the header doesn't have it
+	bool ReadBinaryHeader(const char* data, size_t size, BinaryHeader& header);
+	//Rewrite the header of a finished file with its real record count, fails for anything that can't seek
+	bool FinishBinaryFile(FILE* file, BinaryHeader header, uint64_t count);
+
+	//Pack a puzzle of CellCount characters, and its solution if there is one, into RecordSize bytes
+	//A puzzle with a cell that isn't a value or a blank, which FromLine would turn down, is stored as an Invalid record
+	template <int BoxSize>
+	void PackRecord(const char* puzzle, const char* solution, RecordStatus status, char* record);
+	//Unpack the puzzle and, when the file has them and solution isn't null, the solution as CellCount characters each
+	template <int BoxSize>
+	RecordStatus UnpackRecord(const char* record, bool hasSolutions, char* puzzle, char* solution);
+
+	//Converters between the two formats, returning the number of puzzles written
+	//Text lines are a puzzle, optionally followed by a space and its solution, which is the same layout BinaryToText writes
+	//A file gets solutions when its first line has one, puzzles without one are then stored as unsolved
+	template <int BoxSize>
+	long long TextToBinary(const char* data, size_t size, BufferedWriter& out, BinaryHeader& header);
+	template <int BoxSize>
+	long long BinaryToText(const char* data, size_t size, BufferedWriter& out);
+}
@@ -0,0 +1,139 @@
+#include "Renderer.h"
+#include "Board.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include "ConsoleHelper.h"
+
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+namespace Solver
+{
+    //A non-positive fps draws every change
+    ThrottledRenderer::ThrottledRenderer(int fps)
+        : m_frameTime(fps > 0 ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)) / fps
+                              : std::chrono::steady_clock::duration::zero())
+        , m_nextFrame()
+    {
+    }
+
+    //Skip the frame unless enough time has passed since the last one
+    void ThrottledRenderer::OnBoardChanged(Board const& board)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now < m_nextFrame) { return; }
+
+        m_nextFrame = now + m_frameTime;
+        Draw(board);
+    }
+
+    void ThrottledRenderer::OnSolveFinished(Board const& board)
+    {
+        Draw(board);
+    }
+
+    AnsiRenderer::AnsiRenderer(FILE* out, int fps)
+        : ThrottledRenderer(fps)
+        , m_out(out)
+        , m_cleared(false)
+    {
+#ifdef _WIN32
+        //Windows consoles only understand escape codes once asked to
+        auto hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (GetConsoleMode(hConsole, &mode))
+        {
+            SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        }
+#endif
+    }
+
+    //Build the whole frame in one buffer so each redraw is a single write
+    //Layout matches the console board, cursor is left on the line below it
+    void AnsiRenderer::Draw(Board const& board)
+    {
+        static const char Edge[] = "|-----------------------|\n";
+        static const char Middle[] = "|-------+-------+-------|\n";
+
+        char frame[512];
+        auto pos = 0;
+        auto append = [&](const char* text, int length) {
+            std::copy(text, text + length, frame + pos);
+            pos += length;
+        };
+
+        //Clear once, after that just home the cursor and overwrite
+        if (!m_cleared)
+        {
+            append("\x1b[2J", 4);
+            m_cleared = true;
+        }
+        append("\x1b[H", 3);
+
+        for (auto y = 0; y < 9; ++y)
+        {
+            if (y % 3 == 0)
+            {
+                if (y == 0) { append(Edge, sizeof(Edge) - 1); }
+                else { append(Middle, sizeof(Middle) - 1); }
+            }
+            frame[pos++] = '|';
+            for (auto x = 0; x < 9; ++x)
+            {
+                const auto v = board.GetCell(x, y);
+                frame[pos++] = ' ';
+                frame[pos++] = v ? char('0' + v) : '.';
+                if (x % 3 == 2) { append(" |", 2); }
+            }
+            frame[pos++] = '\n';
+        }
+        append(Edge, sizeof(Edge) - 1);
+
+        fwrite(frame, 1, pos, m_out);
+        fflush(m_out);
+    }
+
+#ifdef _WIN32
+    ConsoleRenderer::ConsoleRenderer(int fps)
+        : ThrottledRenderer(fps)
+    {
+    }
+
+    //Leave the cursor below the board for whatever gets printed next
+    void ConsoleRenderer::OnSolveFinished(Board const& board)
+    {
+        ThrottledRenderer::OnSolveFinished(board);
+        SetCursorEnd();
+    }
+
+    //Print every value in the board
+    void ConsoleRenderer::Draw(Board const& board)
+    {
+        for (auto x = 0; x < 9; ++x)
+        {
+            for (auto y = 0; y < 9; ++y)
+            {
+                SetCursor(x, y, board.GetCell(x, y));
+            }
+        }
+    }
+
+    //The console only knows 9x9 boards, the cells are gathered into a line so the board is read like any other
+    Board ReadConsoleBoard(int board)
+    {
+        char line[Board::CellCount];
+        std::fill(line, line + Board::CellCount, '.');
+        PrintEmptyBoard();
+
+        auto setCursor = [&](int x, int y, int v) { line[y * 9 + x] = v ? (char)('0' + v) : '.'; SetCursor(x, y, v); };
+        ReadBoard(setCursor, board);
+
+        auto b = Board();
+        Board::FromLine(line, b);
+        return b;
+    }
+#endif
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <stdio.h>
+
+#include "BoardObserver.h"
+
+namespace Solver
+{
+	//Draws at most fps frames a second so drawing can't slow down the search
+	//The final board is always drawn
+	class ThrottledRenderer : public BoardObserver
+	{
+	public:
+		explicit ThrottledRenderer(int fps);
+
+		void OnBoardChanged(Board const& board) override;
+		void OnSolveFinished(Board const& board) override;
+
+	protected:
+		virtual void Draw(Board const& board) = 0;
+
+	private:
+		std::chrono::steady_clock::duration m_frameTime;
+		std::chrono::steady_clock::time_point m_nextFrame;
+	};
+
+	//Portable renderer that redraws the whole board with ANSI escape codes
+	class AnsiRenderer : public ThrottledRenderer
+	{
+	public:
+		AnsiRenderer(FILE* out, int fps);
+
+	protected:
+		void Draw(Board const& board) override;
+
+	private:
+		FILE* m_out;
+		bool m_cleared;
+	};
+
+#ifdef _WIN32
+	//Draws into the Windows console using the same layout ReadBoard uses
+	class ConsoleRenderer : public ThrottledRenderer
+	{
+	public:
+		explicit ConsoleRenderer(int fps);
+
+		void OnSolveFinished(Board const& board) override;
+
+	protected:
+		void Draw(Board const& board) override;
+	};
+
+	//Clears the console and reads a board into it, either one of the built-in puzzles or one typed in
+	Board ReadConsoleBoard(int board);
+#endif
+}
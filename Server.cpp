@@ -0,0 +1,600 @@
+#include "Server.h"
+#include "Batch.h"
+#include "FileIo.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+namespace Solver
+{
+    using ServerClock = std::chrono::steady_clock;
+
+    //Reads whatever is there, up to size bytes, returns 0 at the end and -1 on an error
+    long ReadSome(int fd, char* data, size_t size)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        for (;;)
+        {
+            const auto read = ::read(fd, data, size);
+            if (read >= 0 || errno != EINTR) { return (long)read; }
+        }
+#else
+        return _read(fd, data, (unsigned int)size);
+#endif
+    }
+
+    bool WriteAll(int fd, const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            const auto written = ::write(fd, data, size);
+            if (written < 0 && errno == EINTR) { continue; }
+#else
+            const auto written = _write(fd, data, (unsigned int)size);
+#endif
+            if (written <= 0) { return false; }
+            data += written;
+            size -= (size_t)written;
+        }
+        return true;
+    }
+
+    //A client that hangs up is noticed when writing to it fails, rather than the signal ending the process
+    void IgnoreBrokenPipes()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        signal(SIGPIPE, SIG_IGN);
+#endif
+    }
+
+    //Latencies in microseconds, counted in 16 buckets per power of two so a percentile is within about 6%
+    //Keeps the same small footprint however long the server runs
+    struct LatencyHistogram
+    {
+        static const int Buckets = 16 * 40;
+
+        long long Counts[Buckets] = {};
+        long long Total = 0;
+        long long Max = 0;
+
+        static int Bucket(long long us)
+        {
+            if (us < 16) { return (int)std::max(0ll, us); }
+            auto exponent = 0;
+            while ((us >> exponent) >= 32) { ++exponent; }
+            return std::min(Buckets - 1, 16 + exponent * 16 + (int)((us >> exponent) - 16));
+        }
+
+        static long long BucketStart(int bucket)
+        {
+            if (bucket < 16) { return bucket; }
+            return (16ll + (bucket - 16) % 16) << ((bucket - 16) / 16);
+        }
+
+        void Add(long long us)
+        {
+            Counts[Bucket(us)] += 1;
+            Total += 1;
+            Max = std::max(Max, us);
+        }
+
+        void Merge(LatencyHistogram const& other)
+        {
+            for (auto i = 0; i < Buckets; ++i) { Counts[i] += other.Counts[i]; }
+            Total += other.Total;
+            Max = std::max(Max, other.Max);
+        }
+
+        double Percentile(double p) const
+        {
+            const auto rank = std::max(1ll, (long long)(p * Total + 0.5));
+            auto seen = 0ll;
+            for (auto i = 0; i < Buckets; ++i)
+            {
+                seen += Counts[i];
+                if (seen >= rank) { return (double)std::min(BucketStart(i), Max); }
+            }
+            return (double)Max;
+        }
+    };
+
+    //One client. Responses are written under a lock so the lines of different workers never interleave,
+    //and a socket is closed once the last request that needs it has been answered
+    class Connection
+    {
+    public:
+        Connection(int in, int out, bool owned)
+            : m_in(in)
+            , m_out(out)
+            , m_owned(owned)
+            , m_open(true)
+            , m_reading(true)
+        {
+        }
+
+        ~Connection()
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if (m_owned) { close(m_in); }
+#endif
+        }
+
+        Connection(Connection const&) = delete;
+        Connection& operator=(Connection const&) = delete;
+
+        int In() const
+        {
+            return m_in;
+        }
+
+        //A client that went away is written to no more, without holding up anyone else
+        void Write(const char* data, size_t size)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_open) { m_open = WriteAll(m_out, data, size); }
+        }
+
+        //Makes a read waiting on a socket return as if the client were done
+        void StopReading()
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if (m_owned) { shutdown(m_in, SHUT_RD); }
+#endif
+        }
+
+        bool Reading() const
+        {
+            return m_reading.load();
+        }
+
+        void FinishedReading()
+        {
+            m_reading = false;
+        }
+
+    private:
+        int m_in;
+        int m_out;
+        bool m_owned;
+        std::mutex m_mutex;
+        bool m_open;
+        std::atomic<bool> m_reading;
+    };
+
+    struct Request
+    {
+        std::shared_ptr<Connection> Client;
+        std::string Id;
+        std::string Puzzle;
+        ServerClock::time_point Received;
+        //time_point::max() when there is none
+        ServerClock::time_point Deadline;
+    };
+
+    //Requests waiting for a worker. Push blocks while the queue is full, so a reader stops reading and the client's
+    //writes back up behind it
+    class RequestQueue
+    {
+    public:
+        explicit RequestQueue(size_t limit)
+            : m_limit(std::max<size_t>(limit, 1))
+            , m_closed(false)
+        {
+        }
+
+        void Push(Request&& request)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_room.wait(lock, [&] { return m_requests.size() < m_limit; });
+            m_requests.push_back(std::move(request));
+            m_ready.notify_one();
+        }
+
+        //Takes up to count requests, waiting for the first but not for the rest, returns false once closed and empty
+        bool Pop(std::vector<Request>& group, size_t count)
+        {
+            group.clear();
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_ready.wait(lock, [&] { return !m_requests.empty() || m_closed; });
+            if (m_requests.empty()) { return false; }
+            while (group.size() < count && !m_requests.empty())
+            {
+                group.push_back(std::move(m_requests.front()));
+                m_requests.pop_front();
+            }
+            if (!m_requests.empty()) { m_ready.notify_one(); }
+            m_room.notify_all();
+            return true;
+        }
+
+        //Wakes every worker once the last request is taken, only after nothing else will be pushed
+        void Close()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_ready.notify_all();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_ready;
+        std::condition_variable m_room;
+        std::deque<Request> m_requests;
+        size_t m_limit;
+        bool m_closed;
+    };
+
+    //What one worker did, merged into the summary at the end
+    struct WorkerTally
+    {
+        BatchSummary Batch;
+        long long Timeouts = 0;
+        LatencyHistogram Latency;
+    };
+
+    //Splits a line into its ID, puzzle and deadline, a line without a puzzle is still answered, as invalid
+    void QueueRequest(std::shared_ptr<Connection> const& client, const char* line, size_t length, ServerClock::time_point received,
+        int deadlineMs, RequestQueue& queue)
+    {
+        if (length > 0 && line[length - 1] == '\r') { --length; }
+        auto position = line;
+        const auto end = line + length;
+        auto token = [&](const char*& start) {
+            while (position < end && (*position == ' ' || *position == '\t')) { ++position; }
+            start = position;
+            while (position < end && *position != ' ' && *position != '\t') { ++position; }
+            return (size_t)(position - start);
+        };
+
+        const char* id;
+        const char* puzzle;
+        const char* deadline;
+        const auto idLength = token(id);
+        const auto puzzleLength = token(puzzle);
+        const auto deadlineLength = token(deadline);
+        if (idLength == 0) { return; }
+
+        auto request = Request();
+        request.Client = client;
+        request.Id.assign(id, idLength);
+        request.Puzzle.assign(puzzle, puzzleLength);
+        request.Received = received;
+        const auto ms = deadlineLength > 0 ? atoi(std::string(deadline, deadlineLength).c_str()) : deadlineMs;
+        request.Deadline = ms > 0 ? received + std::chrono::milliseconds(ms) : ServerClock::time_point::max();
+        queue.Push(std::move(request));
+    }
+
+    //Room for a padded puzzle plus the ID and deadline, a longer line can't be a request worth reading
+    template <int BoxSize>
+    size_t RequestLineLimit()
+    {
+        return 4 * (size_t)BasicBoard<BoxSize>::CellCount + 64;
+    }
+
+    //Queues a request per line until the client is done, blank lines are skipped
+    //At most lineLimit characters of a line are kept, a longer one is queued with just its ID so it is answered as invalid
+    void ReadRequests(std::shared_ptr<Connection> client, RequestQueue& queue, int deadlineMs, size_t lineLimit)
+    {
+        std::vector<char> buffer(1 << 16);
+        std::string partial;
+        auto overlong = false;
+        auto received = ServerClock::now();
+        auto keep = [&](const char* from, const char* to) {
+            const auto room = lineLimit - partial.size();
+            if ((size_t)(to - from) > room)
+            {
+                to = from + room;
+                overlong = true;
+            }
+            partial.append(from, to);
+        };
+        auto finish = [&](const char* line, size_t length) {
+            if (overlong || length > lineLimit)
+            {
+                auto idEnd = line;
+                while (idEnd < line + length && (*idEnd == ' ' || *idEnd == '\t')) { ++idEnd; }
+                while (idEnd < line + length && *idEnd != ' ' && *idEnd != '\t' && *idEnd != '\r') { ++idEnd; }
+                length = (size_t)(idEnd - line);
+            }
+            QueueRequest(client, line, length, received, deadlineMs, queue);
+            overlong = false;
+        };
+        for (;;)
+        {
+            const auto read = ReadSome(client->In(), buffer.data(), buffer.size());
+            if (read <= 0) { break; }
+            received = ServerClock::now();
+            const char* position = buffer.data();
+            const auto end = position + read;
+            while (position < end)
+            {
+                const auto newline = (const char*)memchr(position, '\n', (size_t)(end - position));
+                if (newline == nullptr)
+                {
+                    keep(position, end);
+                    break;
+                }
+                if (partial.empty() && !overlong) { finish(position, (size_t)(newline - position)); }
+                else
+                {
+                    keep(position, newline);
+                    finish(partial.data(), partial.size());
+                    partial.clear();
+                }
+                position = newline + 1;
+            }
+        }
+        if (!partial.empty() || overlong)
+        {
+            received = ServerClock::now();
+            finish(partial.data(), partial.size());
+        }
+        client->FinishedReading();
+    }
+
+    //Answers requests a group at a time until the queue closes, the ones still in time are propagated together
+    //What propagation answers goes out at once, then each of the rest is searched and answered in turn,
+    //stopping at its own deadline, so a hard puzzle never holds back the easy ones it was grouped with
+    template <int BoxSize>
+    void ServeRequests(RequestQueue& queue, BasicSolveOptions<BoxSize> const& options, WorkerTally& tally)
+    {
+        const auto resultSize = BasicLineSolver<BoxSize>::ResultSize;
+        const auto late = ~(size_t)0;
+        BasicLineSolver<BoxSize> solver;
+        const auto groupSize = (size_t)solver.GroupSize();
+        std::vector<Request> group;
+        std::vector<LineRef> lines(groupSize);
+        //The line each request was given, or late once its deadline has passed, and the request each line came from
+        std::vector<size_t> lineOf(groupSize);
+        std::vector<size_t> requestOf(groupSize);
+        std::vector<size_t> open(groupSize);
+        std::vector<char> searching(groupSize);
+        std::vector<char> results(groupSize * resultSize);
+        std::vector<unsigned short> lengths(groupSize);
+        std::string response;
+        //The requests whose answers are in response, all from one client
+        std::vector<size_t> answered;
+        auto searchOptions = options;
+
+        auto answer = [&](size_t i) {
+            auto const& request = group[i];
+            answered.push_back(i);
+            response += request.Id;
+            response += ' ';
+            if (lineOf[i] == late)
+            {
+                response += "timeout\n";
+                tally.Timeouts += 1;
+            }
+            else { response.append(&results[lineOf[i] * resultSize], lengths[lineOf[i]]); }
+        };
+        auto send = [&]() {
+            group[answered.front()].Client->Write(response.data(), response.size());
+            const auto done = ServerClock::now();
+            for (const auto i : answered)
+            {
+                tally.Latency.Add(std::chrono::duration_cast<std::chrono::microseconds>(done - group[i].Received).count());
+            }
+            response.clear();
+            answered.clear();
+        };
+
+        while (queue.Pop(group, groupSize))
+        {
+            const auto now = ServerClock::now();
+            size_t count = 0;
+            for (size_t i = 0; i < group.size(); ++i)
+            {
+                if (group[i].Deadline < now)
+                {
+                    lineOf[i] = late;
+                    continue;
+                }
+                lineOf[i] = count;
+                requestOf[count] = i;
+                lines[count] = LineRef{ group[i].Puzzle.data(), group[i].Puzzle.size() };
+                ++count;
+            }
+            const auto opened = count > 0 ? solver.Propagate(lines.data(), count, results.data(), lengths.data(), open.data(), options) : 0;
+            std::fill(searching.begin(), searching.end(), 0);
+            for (size_t j = 0; j < opened; ++j) { searching[open[j]] = 1; }
+
+            //Responses to the same client go out in one write
+            for (size_t i = 0; i < group.size(); ++i)
+            {
+                if (lineOf[i] != late && searching[lineOf[i]]) { continue; }
+                if (!answered.empty() && group[i].Client != group[answered.front()].Client) { send(); }
+                answer(i);
+            }
+            if (!answered.empty()) { send(); }
+
+            for (size_t j = 0; j < opened; ++j)
+            {
+                const auto line = open[j];
+                const auto i = requestOf[line];
+                searchOptions.Deadline = std::min(options.Deadline, group[i].Deadline);
+                solver.SolveOpen(line, lines.data(), results.data(), lengths.data(), searchOptions);
+                answer(i);
+                send();
+            }
+        }
+        tally.Batch = solver.Summary();
+    }
+
+    //The queue and the workers taking from it, shared by every client
+    template <int BoxSize>
+    class Server
+    {
+    public:
+        Server(BasicSolveOptions<BoxSize> const& options, ServerSettings const& settings)
+            : m_options(options)
+            , m_queue(settings.QueueLimit)
+        {
+            auto threads = settings.Threads > 0 ? settings.Threads : (int)std::thread::hardware_concurrency();
+            threads = std::max(threads, 1);
+            m_tallies.resize(threads);
+            for (auto i = 0; i < threads; ++i)
+            {
+                m_workers.emplace_back([this, i] { ServeRequests<BoxSize>(m_queue, m_options, m_tallies[i]); });
+            }
+        }
+
+        RequestQueue& Queue()
+        {
+            return m_queue;
+        }
+
+        //Answers everything queued, then stops the workers, nothing may be queued after this starts
+        ServerSummary Finish()
+        {
+            m_queue.Close();
+            for (auto& worker : m_workers) { worker.join(); }
+            m_workers.clear();
+
+            auto summary = ServerSummary();
+            auto latency = LatencyHistogram();
+            for (auto const& tally : m_tallies)
+            {
+                summary.Requests += tally.Batch.Puzzles + tally.Timeouts;
+                summary.Solved += tally.Batch.Solved;
+                summary.Unsolvable += tally.Batch.Unsolvable;
+                summary.Invalid += tally.Batch.Invalid;
+                summary.Stopped += tally.Batch.Stopped;
+                summary.Timeouts += tally.Timeouts;
+                latency.Merge(tally.Latency);
+            }
+            summary.P50Us = latency.Percentile(0.5);
+            summary.P99Us = latency.Percentile(0.99);
+            summary.MaxUs = (double)latency.Max;
+            return summary;
+        }
+
+    private:
+        BasicSolveOptions<BoxSize> m_options;
+        RequestQueue m_queue;
+        std::vector<WorkerTally> m_tallies;
+        std::vector<std::thread> m_workers;
+    };
+
+    template <int BoxSize>
+    ServerSummary ServeStream(int in, int out, BasicSolveOptions<BoxSize> const& options, ServerSettings const& settings)
+    {
+        IgnoreBrokenPipes();
+        Server<BoxSize> server(options, settings);
+        ReadRequests(std::make_shared<Connection>(in, out, false), server.Queue(), settings.DeadlineMs, RequestLineLimit<BoxSize>());
+        return server.Finish();
+    }
+
+    //The socket ServeSocket is waiting on, so StopServer can wake it
+    std::atomic<int> ListeningSocket(-1);
+    volatile sig_atomic_t StopRequested = 0;
+
+    void StopServer()
+    {
+        StopRequested = 1;
+#if defined(__unix__) || defined(__APPLE__)
+        const auto listening = ListeningSocket.load();
+        if (listening >= 0) { shutdown(listening, SHUT_RDWR); }
+#endif
+    }
+
+    template <int BoxSize>
+    bool ServeSocket(const char* path, BasicSolveOptions<BoxSize> const& options, ServerSettings const& settings, ServerSummary& summary)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        auto address = sockaddr_un();
+        address.sun_family = AF_UNIX;
+        if (strlen(path) >= sizeof(address.sun_path)) { return false; }
+        strcpy(address.sun_path, path);
+
+        const auto listening = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listening < 0) { return false; }
+        unlink(path);
+        if (bind(listening, (sockaddr*)&address, sizeof(address)) != 0 || listen(listening, SOMAXCONN) != 0)
+        {
+            close(listening);
+            return false;
+        }
+        IgnoreBrokenPipes();
+        ListeningSocket = listening;
+
+        //Each client has a thread reading its requests, joined once the client is done
+        //Only the reader and the requests hold on to a client, so it is closed as soon as the last response is written
+        struct Reader
+        {
+            std::thread Thread;
+            std::weak_ptr<Connection> Client;
+        };
+        std::vector<Reader> readers;
+        Server<BoxSize> server(options, settings);
+        while (!StopRequested)
+        {
+            const auto client = accept(listening, nullptr, nullptr);
+            if (client < 0)
+            {
+                if (errno == EINTR || errno == ECONNABORTED) { continue; }
+                break;
+            }
+
+            size_t kept = 0;
+            for (size_t i = 0; i < readers.size(); ++i)
+            {
+                const auto client = readers[i].Client.lock();
+                if (client == nullptr || !client->Reading()) { readers[i].Thread.join(); }
+                else if (kept++ != i) { readers[kept - 1] = std::move(readers[i]); }
+            }
+            readers.erase(readers.begin() + kept, readers.end());
+
+            auto connection = std::make_shared<Connection>(client, client, true);
+            std::thread thread(ReadRequests, connection, std::ref(server.Queue()), settings.DeadlineMs, RequestLineLimit<BoxSize>());
+            readers.push_back(Reader{ std::move(thread), connection });
+        }
+
+        ListeningSocket = -1;
+        close(listening);
+        unlink(path);
+        //Clients still connected are read no further, what they have sent already is answered
+        for (auto& reader : readers)
+        {
+            if (auto client = reader.Client.lock()) { client->StopReading(); }
+            reader.Thread.join();
+        }
+        summary = server.Finish();
+        return true;
+#else
+        (void)path;
+        (void)options;
+        (void)settings;
+        (void)summary;
+        return false;
+#endif
+    }
+
+    template ServerSummary ServeStream<3>(int, int, BasicSolveOptions<3> const&, ServerSettings const&);
+    template ServerSummary ServeStream<4>(int, int, BasicSolveOptions<4> const&, ServerSettings const&);
+    template ServerSummary ServeStream<5>(int, int, BasicSolveOptions<5> const&, ServerSettings const&);
+    template bool ServeSocket<3>(const char*, BasicSolveOptions<3> const&, ServerSettings const&, ServerSummary&);
+    template bool ServeSocket<4>(const char*, BasicSolveOptions<4> const&, ServerSettings const&, ServerSummary&);
+    template bool ServeSocket<5>(const char*, BasicSolveOptions<5> const&, ServerSettings const&, ServerSummary&);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stddef.h>
+
+#include "Board.h"
+
+namespace Solver
+{
+	//How a server takes requests, the solve itself is set by the options it is given
+	struct ServerSettings
+	{
+		//Workers solving requests, 0 uses every hardware thread
+		int Threads = 0;
+		//Requests waiting for a worker before reading stops, which pushes back on clients through their pipes and sockets
+		size_t QueueLimit = 4096;
+		//Milliseconds a request may take from being read to being answered, 0 for no limit, a request can set its own
+		int DeadlineMs = 0;
+	};
+
+	struct ServerSummary
+	{
+		long long Requests = 0;
+		long long Solved = 0;
+		long long Unsolvable = 0;
+		long long Invalid = 0;
+		//Requests answered with timeout because their deadline passed before a worker took them
+		long long Timeouts = 0;
+		//Requests whose solve was stopped by their deadline or a budget in the options, answered with exceeded
+		long long Stopped = 0;
+		//Microseconds from reading a request to writing its response, to within about 6%
+		double P50Us = 0;
+		double P99Us = 0;
+		double MaxUs = 0;
+	};
+
+	//Each request is one line: an ID without spaces, the puzzle, and optionally a deadline in milliseconds, separated by spaces
+	//Each response is one line: the ID, a space, then what batch mode writes for the puzzle, or timeout when its deadline
+	//passed first. Responses are written as they finish, so they can come back in a different order from the requests.
+	//Workers take whatever requests are waiting, up to a lockstep group at a time, and never wait for a group to fill.
+	//A deadline is checked when a worker takes the request, and a solve still running at the latest deadline of the
+	//requests taken with it is stopped.
+
+	//Serves requests read from the file descriptor in and writes responses to out, until in ends
+	template <int BoxSize = 3>
+	ServerSummary ServeStream(int in, int out, BasicSolveOptions<BoxSize> const& options, ServerSettings const& settings);
+	//Serves every client that connects to a Unix domain socket at path until StopServer is called
+	//Any file at path is replaced. Returns false if the socket can't be set up, or where there are no Unix domain sockets
+	template <int BoxSize = 3>
+	bool ServeSocket(const char* path, BasicSolveOptions<BoxSize> const& options, ServerSettings const& settings, ServerSummary& summary);
+	//Stops ServeSocket taking connections and has it finish the requests it has already read
+	//Safe to call from a signal handler
+	void StopServer();
+}
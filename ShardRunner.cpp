@@ -0,0 +1,373 @@
+#include "ShardRunner.h"
+#include "FileIo.h"
+#include "PuzzleFile.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace Solver
+{
+    //A run of whole lines of the corpus, sent to a worker byte for byte
+    struct Shard
+    {
+        long long Index;
+        size_t Begin;
+        size_t End;
+        long long Puzzles;
+    };
+
+    //How far a run got, saved after every shard written. Offsets are in bytes, so a run resumes without counting lines
+    struct Checkpoint
+    {
+        unsigned long long CorpusSize = 0;
+        unsigned long long Input = 0;
+        unsigned long long Output = 0;
+        long long Puzzles = 0;
+        long long Solved = 0;
+        long long Unsolvable = 0;
+        long long Invalid = 0;
+        long long Stopped = 0;
+    };
+
+    bool ReadCheckpoint(const char* path, Checkpoint& checkpoint)
+    {
+        auto file = fopen(path, "rb");
+        if (file == nullptr) { return false; }
+        const auto fields = fscanf(file, "sudoku-shards 1 %llu %llu %llu %lld %lld %lld %lld %lld", &checkpoint.CorpusSize,
+            &checkpoint.Input, &checkpoint.Output, &checkpoint.Puzzles, &checkpoint.Solved, &checkpoint.Unsolvable,
+            &checkpoint.Invalid, &checkpoint.Stopped);
+        fclose(file);
+        return fields == 8;
+    }
+
+    //Results are tallied by their first character, solutions start with a value or a count and status words don't
+    void CountResults(std::string const& results, Checkpoint& totals)
+    {
+        for (size_t position = 0; position < results.size(); position = results.find('\n', position) + 1)
+        {
+            totals.Puzzles += 1;
+            switch (results[position])
+            {
+            case 'i': totals.Invalid += 1; break;
+            case 'u': totals.Unsolvable += 1; break;
+            case 'e':
+            case 'c': totals.Stopped += 1; break;
+            default: totals.Solved += 1; break;
+            }
+        }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    //Written beside the checkpoint and renamed over it, so a crash leaves either the old one or the new one
+    bool WriteCheckpoint(std::string const& path, Checkpoint const& checkpoint)
+    {
+        const auto temporary = path + ".tmp";
+        auto file = fopen(temporary.c_str(), "wb");
+        if (file == nullptr) { return false; }
+        auto written = fprintf(file, "sudoku-shards 1 %llu %llu %llu %lld %lld %lld %lld %lld\n", checkpoint.CorpusSize, checkpoint.Input,
+            checkpoint.Output, checkpoint.Puzzles, checkpoint.Solved, checkpoint.Unsolvable, checkpoint.Invalid, checkpoint.Stopped) > 0;
+        written = fflush(file) == 0 && fsync(fileno(file)) == 0 && written;
+        written = fclose(file) == 0 && written;
+        return written && rename(temporary.c_str(), path.c_str()) == 0;
+    }
+
+    //Pipes are made close-on-exec under this lock, so a worker started from another thread never holds the ends
+    //of someone else's pipes open
+    std::mutex SpawnMutex;
+
+    bool MakePipe(int ends[2])
+    {
+        if (pipe(ends) != 0) { return false; }
+        fcntl(ends[0], F_SETFD, FD_CLOEXEC);
+        fcntl(ends[1], F_SETFD, FD_CLOEXEC);
+        return true;
+    }
+
+    //Starts the command with its stdin and stdout on pipes and its stderr thrown away, returns the pid or -1
+    pid_t StartWorker(std::vector<std::string> const& command, int& input, int& output)
+    {
+        std::vector<char*> arguments;
+        for (auto const& argument : command) { arguments.push_back(const_cast<char*>(argument.c_str())); }
+        arguments.push_back(nullptr);
+
+        std::lock_guard<std::mutex> lock(SpawnMutex);
+        int toWorker[2];
+        int fromWorker[2];
+        if (!MakePipe(toWorker)) { return -1; }
+        if (!MakePipe(fromWorker))
+        {
+            close(toWorker[0]);
+            close(toWorker[1]);
+            return -1;
+        }
+
+        const auto pid = fork();
+        if (pid == 0)
+        {
+            const auto null = open("/dev/null", O_WRONLY | O_CLOEXEC);
+            dup2(toWorker[0], 0);
+            dup2(fromWorker[1], 1);
+            if (null >= 0) { dup2(null, 2); }
+            execvp(arguments[0], arguments.data());
+            _exit(127);
+        }
+
+        close(toWorker[0]);
+        close(fromWorker[1]);
+        if (pid < 0)
+        {
+            close(toWorker[1]);
+            close(fromWorker[0]);
+            return -1;
+        }
+        input = toWorker[1];
+        output = fromWorker[0];
+        return pid;
+    }
+
+    //Feeds a shard to a new worker and collects its results
+    //Fails if the worker can't start, doesn't exit cleanly or doesn't answer every puzzle
+    bool RunWorker(std::vector<std::string> const& command, const char* data, size_t size, long long puzzles, std::string& results)
+    {
+        results.clear();
+        auto input = -1;
+        auto output = -1;
+        const auto pid = StartWorker(command, input, output);
+        if (pid < 0) { return false; }
+
+        //Writing never blocks, since a worker stops reading while its results are left unread
+        fcntl(input, F_SETFL, fcntl(input, F_GETFL) | O_NONBLOCK);
+        std::vector<char> buffer(1 << 16);
+        size_t sent = 0;
+        while (output >= 0)
+        {
+            if (input >= 0 && sent == size)
+            {
+                close(input);
+                input = -1;
+            }
+
+            pollfd polled[2] = { { output, POLLIN, 0 }, { input, POLLOUT, 0 } };
+            if (poll(polled, input >= 0 ? 2 : 1, -1) < 0)
+            {
+                if (errno == EINTR) { continue; }
+                break;
+            }
+            if (input >= 0 && polled[1].revents != 0)
+            {
+                const auto written = write(input, data + sent, std::min(size - sent, buffer.size()));
+                if (written > 0) { sent += (size_t)written; }
+                else if (errno != EAGAIN && errno != EINTR)
+                {
+                    //The worker stopped reading, what it did write still counts against the shard
+                    close(input);
+                    input = -1;
+                }
+            }
+            if (polled[0].revents != 0)
+            {
+                const auto read = ::read(output, buffer.data(), buffer.size());
+                if (read > 0) { results.append(buffer.data(), (size_t)read); }
+                else if (read == 0 || errno != EINTR)
+                {
+                    close(output);
+                    output = -1;
+                }
+            }
+        }
+        if (input >= 0) { close(input); }
+        if (output >= 0) { close(output); }
+
+        auto status = 0;
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0 && !results.empty() && results.back() == '\n'
+            && std::count(results.begin(), results.end(), '\n') == puzzles;
+    }
+
+    bool RunShards(const char* inPath, const char* outPath, const char* checkpointPath, ShardSettings const& settings,
+        ShardSummary& summary)
+    {
+        summary = ShardSummary();
+        if (settings.WorkerCommand.empty())
+        {
+            summary.Failure = "No worker command";
+            return false;
+        }
+        MappedFile corpus;
+        if (!corpus.Open(inPath))
+        {
+            summary.Failure = std::string("Unable to open ") + inPath;
+            return false;
+        }
+        auto header = BinaryHeader();
+        if (ReadBinaryHeader(corpus.Data(), corpus.Size(), header))
+        {
+            summary.Failure = std::string(inPath) + " is a binary puzzle file, convert it with --to-text first";
+            return false;
+        }
+
+        //A checkpoint for another corpus is left alone rather than thrown away with the results it stands for
+        auto done = Checkpoint();
+        const auto resuming = ReadCheckpoint(checkpointPath, done);
+        if (resuming && (done.CorpusSize != corpus.Size() || done.Input > corpus.Size()))
+        {
+            summary.Failure = std::string(checkpointPath) + " is from a run on a different corpus";
+            return false;
+        }
+        FILE* out = nullptr;
+        if (resuming)
+        {
+            //Whatever was written after the checkpoint comes from shards that will be run again
+            out = fopen(outPath, "r+b");
+            if (out == nullptr || fseeko(out, 0, SEEK_END) != 0 || (unsigned long long)ftello(out) < done.Output
+                || ftruncate(fileno(out), (off_t)done.Output) != 0 || fseeko(out, 0, SEEK_END) != 0)
+            {
+                if (out != nullptr) { fclose(out); }
+                summary.Failure = std::string("Unable to resume writing ") + outPath + " from the checkpoint";
+                return false;
+            }
+        }
+        else
+        {
+            done.CorpusSize = corpus.Size();
+            out = fopen(outPath, "wb");
+            if (out == nullptr)
+            {
+                summary.Failure = std::string("Unable to create ") + outPath;
+                return false;
+            }
+        }
+        summary.Resumed = done.Puzzles;
+        signal(SIGPIPE, SIG_IGN);
+
+        //Workers take shards in order, no further ahead of the writer than the window, so results waiting
+        //for an earlier shard never pile up
+        const auto workers = std::max(1, settings.Workers > 0 ? settings.Workers : (int)std::thread::hardware_concurrency());
+        const auto window = 2ll * workers;
+        const auto shardSize = std::max(1ll, settings.ShardSize);
+        const auto data = corpus.Data();
+        const auto end = data + corpus.Size();
+        auto position = data + done.Input;
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::map<long long, std::pair<Shard, std::string>> finished;
+        auto nextShard = 0ll;
+        auto written = 0ll;
+        auto running = workers;
+        auto failed = false;
+
+        auto work = [&]()
+        {
+            std::string results;
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;)
+            {
+                changed.wait(lock, [&] { return failed || nextShard < written + window; });
+                if (failed) { break; }
+                auto shard = Shard{ nextShard, (size_t)(position - data), 0, 0 };
+                LineRef line;
+                while (shard.Puzzles < shardSize && NextLine(position, end, line)) { shard.Puzzles += 1; }
+                shard.End = (size_t)(position - data);
+                if (shard.Puzzles == 0) { break; }
+                nextShard += 1;
+                lock.unlock();
+
+                auto ok = false;
+                for (auto attempt = 0; attempt < std::max(1, settings.Attempts) && !ok; ++attempt)
+                {
+                    if (attempt > 0)
+                    {
+                        std::lock_guard<std::mutex> retry(mutex);
+                        summary.Retries += 1;
+                    }
+                    ok = RunWorker(settings.WorkerCommand, data + shard.Begin, shard.End - shard.Begin, shard.Puzzles, results);
+                }
+
+                lock.lock();
+                if (ok) { finished[shard.Index] = std::make_pair(shard, std::move(results)); }
+                else if (!failed)
+                {
+                    failed = true;
+                    summary.Failure = "Shard " + std::to_string(shard.Index + 1) + " failed on every attempt";
+                }
+                changed.notify_all();
+            }
+            running -= 1;
+            changed.notify_all();
+        };
+
+        std::vector<std::thread> threads;
+        for (auto i = 0; i < workers; ++i) { threads.emplace_back(work); }
+
+        //Shards are written as soon as every one before them is, each followed by a checkpoint
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;)
+            {
+                changed.wait(lock, [&] { return finished.count(written) > 0 || running == 0; });
+                const auto next = finished.find(written);
+                if (next == finished.end()) { break; }
+                const auto shard = next->second.first;
+                const auto results = std::move(next->second.second);
+                finished.erase(next);
+                lock.unlock();
+
+                auto saved = fwrite(results.data(), 1, results.size(), out) == results.size()
+                    && fflush(out) == 0 && fsync(fileno(out)) == 0;
+                if (saved)
+                {
+                    done.Input = shard.End;
+                    done.Output += results.size();
+                    CountResults(results, done);
+                    saved = WriteCheckpoint(checkpointPath, done);
+                }
+
+                lock.lock();
+                if (!saved)
+                {
+                    if (!failed) { summary.Failure = std::string("Unable to write ") + outPath + " or its checkpoint"; }
+                    failed = true;
+                    changed.notify_all();
+                    break;
+                }
+                written += 1;
+                summary.Shards += 1;
+                changed.notify_all();
+            }
+        }
+        for (auto& thread : threads) { thread.join(); }
+        fclose(out);
+
+        summary.Puzzles = done.Puzzles;
+        summary.Solved = done.Solved;
+        summary.Unsolvable = done.Unsolvable;
+        summary.Invalid = done.Invalid;
+        summary.Stopped = done.Stopped;
+        if (failed) { return false; }
+        remove(checkpointPath);
+        return true;
+    }
+#else
+    bool RunShards(const char*, const char*, const char*, ShardSettings const&, ShardSummary& summary)
+    {
+        summary = ShardSummary();
+        summary.Failure = "Sharded runs start their workers with fork and pipes, which this platform doesn't have";
+        return false;
+    }
+#endif
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Solver
+{
+	//How a corpus is split into shards and handed out to worker processes
+	struct ShardSettings
+	{
+		//Worker processes running at once, 0 for one per hardware thread
+		int Workers = 0;
+		//Puzzles per shard, progress is saved each time a shard is written
+		long long ShardSize = 100000;
+		//A worker's command line. It reads a shard of puzzle lines on stdin and writes a result line per puzzle to
+		//stdout, the way --batch - does, so this can as well run the solver on another machine
+		std::vector<std::string> WorkerCommand;
+		//Runs of a shard before giving up on it, for workers that crash or are killed
+		int Attempts = 3;
+	};
+
+	struct ShardSummary
+	{
+		long long Puzzles = 0;
+		long long Solved = 0;
+		long long Unsolvable = 0;
+		long long Invalid = 0;
+		long long Stopped = 0;
+		//Of the puzzles above, the ones an earlier run had finished
+		long long Resumed = 0;
+		long long Shards = 0;
+		//Shards run again after a worker failed
+		long long Retries = 0;
+		//Why the run stopped early, empty when it finished
+		std::string Failure;
+	};
+
+	//Solves every line of the text corpus at inPath across worker processes and writes the results to outPath in input order
+	//After each shard is written the position in both files goes to checkpointPath, and a run that finds a checkpoint for
+	//the same corpus carries on from it, dropping anything written after it. The checkpoint is removed once the run finishes.
+	//Returns false with the reason in summary.Failure if a file can't be used, a shard fails every attempt, or there is no
+	//fork and pipes to start workers with; the checkpoint then holds everything finished.
+	bool RunShards(const char* inPath, const char* outPath, const char* checkpointPath, ShardSettings const& settings,
+		ShardSummary& summary);
+}
@@ -0,0 +1,270 @@
+#include "SolutionCache.h"
+
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+
+namespace Solver
+{
+    //Shards are split off while each keeps at least this many puzzles, up to MaxCacheShardBits of them
+    const size_t MinCacheShardSize = 64;
+    const int MaxCacheShardBits = 4;
+
+    template <int BoxSize>
+    struct BasicSolutionCache<BoxSize>::Entry
+    {
+        uint64_t Hash;
+        char Key[CellCount];
+        //Of the canonical form, so it has to go through the inverse transform of whoever looks it up
+        char Solution[CellCount];
+        int Solutions;
+        int SolutionLimit;
+        //Neighbours in the recently used list, -1 past either end
+        int Newer;
+        int Older;
+        SolveStatus Status;
+    };
+
+    //Entries are allocated once up front and found through an open addressing table of their indices
+    template <int BoxSize>
+    struct BasicSolutionCache<BoxSize>::Shard
+    {
+        std::mutex Mutex;
+        std::vector<Entry> Entries;
+        size_t Capacity = 0;
+        //Linear probing, each slot is an index into Entries or -1
+        std::vector<int> Table;
+        size_t Mask = 0;
+        int Newest = -1;
+        int Oldest = -1;
+        char Padding[64];
+
+        //The slot holding key, or the empty slot where it would go
+        size_t FindSlot(uint64_t hash, const char* key) const
+        {
+            for (auto slot = (size_t)hash & Mask;; slot = (slot + 1) & Mask)
+            {
+                const auto index = Table[slot];
+                if (index < 0) { return slot; }
+                auto const& entry = Entries[index];
+                if (entry.Hash == hash && memcmp(entry.Key, key, CellCount) == 0) { return slot; }
+            }
+        }
+
+        //Empties a slot and moves later entries of the same run back into it, so no probe ever stops short
+        void RemoveSlot(size_t slot)
+        {
+            auto hole = slot;
+            for (auto next = (hole + 1) & Mask; Table[next] >= 0; next = (next + 1) & Mask)
+            {
+                const auto home = (size_t)Entries[Table[next]].Hash & Mask;
+                if (((next - home) & Mask) >= ((next - hole) & Mask))
+                {
+                    Table[hole] = Table[next];
+                    hole = next;
+                }
+            }
+            Table[hole] = -1;
+        }
+
+        void Unlink(int index)
+        {
+            auto& entry = Entries[index];
+            if (entry.Newer >= 0) { Entries[entry.Newer].Older = entry.Older; }
+            else { Newest = entry.Older; }
+            if (entry.Older >= 0) { Entries[entry.Older].Newer = entry.Newer; }
+            else { Oldest = entry.Newer; }
+        }
+
+        void PushNewest(int index)
+        {
+            auto& entry = Entries[index];
+            entry.Newer = -1;
+            entry.Older = Newest;
+            if (Newest >= 0) { Entries[Newest].Newer = index; }
+            Newest = index;
+            if (Oldest < 0) { Oldest = index; }
+        }
+    };
+
+    //FNV-1a, canonical forms differ early so nothing stronger is needed
+    template <int BoxSize>
+    uint64_t HashCanonical(const char* key)
+    {
+        auto hash = (uint64_t)14695981039346656037ull;
+        for (auto i = 0; i < BasicBoard<BoxSize>::CellCount; ++i)
+        {
+            hash = (hash ^ (unsigned char)key[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    //A result found with one limit answers another when it is the exact count, or when the other limit is no higher
+    bool AnswersLimit(SolveStatus status, int solutions, int entryLimit, int solutionLimit)
+    {
+        return status == SolveStatus::Unsolvable || solutions < entryLimit || solutionLimit <= entryLimit;
+    }
+
+    template <int BoxSize>
+    BasicSolutionCache<BoxSize>::BasicSolutionCache(size_t capacity)
+        : m_shardBits(0)
+        , m_capacity(std::max<size_t>(capacity, 1))
+        , m_lookups(0)
+        , m_hits(0)
+        , m_inserts(0)
+        , m_evictions(0)
+        , m_skipped(0)
+        , m_lookupNs(0)
+    {
+        while (m_shardBits < MaxCacheShardBits && (m_capacity >> (m_shardBits + 1)) >= MinCacheShardSize) { ++m_shardBits; }
+        const auto shards = (size_t)1 << m_shardBits;
+        const auto shardCapacity = (m_capacity + shards - 1) >> m_shardBits;
+        auto tableSize = (size_t)1;
+        while (tableSize < 2 * shardCapacity) { tableSize <<= 1; }
+
+        m_shards.reset(new Shard[shards]);
+        for (size_t i = 0; i < shards; ++i)
+        {
+            auto& shard = m_shards[i];
+            shard.Capacity = shardCapacity;
+            shard.Entries.reserve(shardCapacity);
+            shard.Table.assign(tableSize, -1);
+            shard.Mask = tableSize - 1;
+        }
+    }
+
+    template <int BoxSize>
+    BasicSolutionCache<BoxSize>::~BasicSolutionCache() = default;
+
+    template <int BoxSize>
+    typename BasicSolutionCache<BoxSize>::Shard& BasicSolutionCache<BoxSize>::ShardFor(uint64_t hash)
+    {
+        return m_shards[m_shardBits > 0 ? (size_t)(hash >> (64 - m_shardBits)) : 0];
+    }
+
+    template <int BoxSize>
+    bool BasicSolutionCache<BoxSize>::Lookup(const char* puzzle, int solutionLimit, BasicCacheQuery<BoxSize>& query, SolveStatus& status,
+        char* solution, int& solutions)
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto begin = Clock::now();
+        m_lookups.fetch_add(1, std::memory_order_relaxed);
+        query.SolutionLimit = solutionLimit;
+        query.Cacheable = Canonicalize<BoxSize>(puzzle, query.Canonical, query.Transform);
+
+        auto found = false;
+        char canonicalSolution[CellCount];
+        if (!query.Cacheable)
+        {
+            m_skipped.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            const auto hash = HashCanonical<BoxSize>(query.Canonical);
+            auto& shard = ShardFor(hash);
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+            const auto index = shard.Table[shard.FindSlot(hash, query.Canonical)];
+            if (index >= 0)
+            {
+                auto const& entry = shard.Entries[index];
+                if (AnswersLimit(entry.Status, entry.Solutions, entry.SolutionLimit, solutionLimit))
+                {
+                    found = true;
+                    status = entry.Status;
+                    solutions = std::min(entry.Solutions, solutionLimit);
+                    std::copy(entry.Solution, entry.Solution + CellCount, canonicalSolution);
+                    shard.Unlink(index);
+                    shard.PushNewest(index);
+                }
+            }
+        }
+
+        if (found)
+        {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            if (status == SolveStatus::Solved) { InvertTransform<BoxSize>(query.Transform, canonicalSolution, solution); }
+        }
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+        m_lookupNs.fetch_add((long long)ns, std::memory_order_relaxed);
+        return found;
+    }
+
+    template <int BoxSize>
+    void BasicSolutionCache<BoxSize>::Insert(BasicCacheQuery<BoxSize> const& query, SolveStatus status, const char* solution, int solutions)
+    {
+        if (!query.Cacheable || (status != SolveStatus::Solved && status != SolveStatus::Unsolvable)) { return; }
+
+        char canonicalSolution[CellCount] = {};
+        if (status == SolveStatus::Solved) { ApplyTransform<BoxSize>(query.Transform, solution, canonicalSolution); }
+        const auto hash = HashCanonical<BoxSize>(query.Canonical);
+        auto& shard = ShardFor(hash);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+
+        auto slot = shard.FindSlot(hash, query.Canonical);
+        auto index = shard.Table[slot];
+        if (index >= 0)
+        {
+            //Another thread got there first, keep whichever was solved with the higher limit
+            auto& entry = shard.Entries[index];
+            if (query.SolutionLimit > entry.SolutionLimit)
+            {
+                std::copy(canonicalSolution, canonicalSolution + CellCount, entry.Solution);
+                entry.Solutions = solutions;
+                entry.SolutionLimit = query.SolutionLimit;
+                entry.Status = status;
+            }
+            shard.Unlink(index);
+            shard.PushNewest(index);
+            return;
+        }
+
+        if (shard.Entries.size() < shard.Capacity)
+        {
+            index = (int)shard.Entries.size();
+            shard.Entries.emplace_back();
+        }
+        else
+        {
+            index = shard.Oldest;
+            auto const& oldest = shard.Entries[index];
+            shard.Unlink(index);
+            shard.RemoveSlot(shard.FindSlot(oldest.Hash, oldest.Key));
+            slot = shard.FindSlot(hash, query.Canonical);
+            m_evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto& entry = shard.Entries[index];
+        entry.Hash = hash;
+        std::copy(query.Canonical, query.Canonical + CellCount, entry.Key);
+        std::copy(canonicalSolution, canonicalSolution + CellCount, entry.Solution);
+        entry.Solutions = solutions;
+        entry.SolutionLimit = query.SolutionLimit;
+        entry.Status = status;
+        shard.Table[slot] = index;
+        shard.PushNewest(index);
+        m_inserts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <int BoxSize>
+    size_t BasicSolutionCache<BoxSize>::Capacity() const
+    {
+        return m_capacity;
+    }
+
+    template <int BoxSize>
+    CacheStats BasicSolutionCache<BoxSize>::Stats() const
+    {
+        auto stats = CacheStats();
+        stats.Lookups = m_lookups.load(std::memory_order_relaxed);
+        stats.Hits = m_hits.load(std::memory_order_relaxed);
+        stats.Inserts = m_inserts.load(std::memory_order_relaxed);
+        stats.Evictions = m_evictions.load(std::memory_order_relaxed);
+        stats.Skipped = m_skipped.load(std::memory_order_relaxed);
+        stats.LookupNs = m_lookupNs.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    template class BasicSolutionCache<3>;
+    template class BasicSolutionCache<4>;
+    template class BasicSolutionCache<5>;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Canonical.h"
+
+namespace Solver
+{
+	//Counters of a cache, read while it is in use so they are only roughly in step with each other
+	struct CacheStats
+	{
+		long long Lookups = 0;
+		long long Hits = 0;
+		long long Inserts = 0;
+		long long Evictions = 0;
+		//Lookups of puzzles without a canonical form, which are solved without touching the cache
+		long long Skipped = 0;
+		//Time spent in Lookup, canonicalizing included
+		long long LookupNs = 0;
+	};
+
+	//What a lookup worked out about a puzzle, kept so a miss can be inserted once solved without canonicalizing again
+	template <int BoxSize>
+	struct BasicCacheQuery
+	{
+		char Canonical[BasicBoard<BoxSize>::CellCount];
+		BasicGridTransform<BoxSize> Transform;
+		int SolutionLimit;
+		bool Cacheable;
+	};
+
+	//Solved puzzles keyed by their canonical form, so a puzzle that is a relabeled, reflected or shuffled copy of one
+	//seen before is answered with that one's solution taken back through the transform
+	//Holds at most capacity puzzles and drops the least recently used one to make room. Puzzles are spread over
+	//shards by hash, each with its own lock, so threads rarely wait on each other.
+	//A multiple solution puzzle answered from the cache gets the solution of the copy that was solved, which is one of
+	//its solutions but not always the first the search would find
+	template <int BoxSize>
+	class BasicSolutionCache
+	{
+	public:
+		static const int CellCount = BasicBoard<BoxSize>::CellCount;
+
+		explicit BasicSolutionCache(size_t capacity);
+		~BasicSolutionCache();
+		BasicSolutionCache(BasicSolutionCache const&) = delete;
+		BasicSolutionCache& operator=(BasicSolutionCache const&) = delete;
+
+		//Returns true with the status, solution and solution count of a puzzle of CellCount characters when a copy of
+		//it was solved with a limit that answers this one. solution is only written when solved
+		//Otherwise query is filled in for Insert
+		bool Lookup(const char* puzzle, int solutionLimit, BasicCacheQuery<BoxSize>& query, SolveStatus& status, char* solution,
+			int& solutions);
+		//Stores the result of a puzzle Lookup missed, only solved and unsolvable puzzles are kept
+		void Insert(BasicCacheQuery<BoxSize> const& query, SolveStatus status, const char* solution, int solutions);
+
+		size_t Capacity() const;
+		CacheStats Stats() const;
+
+	private:
+		struct Entry;
+		struct Shard;
+
+		Shard& ShardFor(uint64_t hash);
+
+		std::unique_ptr<Shard[]> m_shards;
+		int m_shardBits;
+		size_t m_capacity;
+
+		std::atomic<long long> m_lookups;
+		std::atomic<long long> m_hits;
+		std::atomic<long long> m_inserts;
+		std::atomic<long long> m_evictions;
+		std::atomic<long long> m_skipped;
+		std::atomic<long long> m_lookupNs;
+	};
+
+	using SolutionCache = BasicSolutionCache<3>;
+}
@@ -0,0 +1,113 @@
+#include "SolveStats.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+namespace Solver
+{
+    void AddStats(SolveStats& total, SolveStats const& part)
+    {
+        total.Guesses += part.Guesses;
+        total.Backtracks += part.Backtracks;
+        total.MaxDepth = std::max(total.MaxDepth, part.MaxDepth);
+        total.SolveKnownIterations += part.SolveKnownIterations;
+        total.Singles += part.Singles;
+        total.HiddenSingles += part.HiddenSingles;
+        total.Copies += part.Copies;
+        total.PropagationNs += part.PropagationNs;
+        total.SearchNs += part.SearchNs;
+        //Hardware counts only add up if both sides have them
+        total.Cycles = (total.Cycles < 0 || part.Cycles < 0) ? -1 : total.Cycles + part.Cycles;
+        total.BranchMisses = (total.BranchMisses < 0 || part.BranchMisses < 0) ? -1 : total.BranchMisses + part.BranchMisses;
+        total.CacheMisses = (total.CacheMisses < 0 || part.CacheMisses < 0) ? -1 : total.CacheMisses + part.CacheMisses;
+    }
+
+#ifdef __linux__
+    //Counts one hardware event for the calling thread in user space, starting disabled
+    //The first counter leads a group the others join, so all three start and stop together
+    int OpenCounter(unsigned long long config, int group)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = group < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+    }
+
+    long long ReadCounter(int counter)
+    {
+        long long value = 0;
+        return read(counter, &value, sizeof(value)) == sizeof(value) ? value : -1;
+    }
+
+    HardwareCounters::HardwareCounters()
+        : m_cycles(OpenCounter(PERF_COUNT_HW_CPU_CYCLES, -1))
+        , m_branchMisses(m_cycles < 0 ? -1 : OpenCounter(PERF_COUNT_HW_BRANCH_MISSES, m_cycles))
+        , m_cacheMisses(m_cycles < 0 ? -1 : OpenCounter(PERF_COUNT_HW_CACHE_MISSES, m_cycles))
+    {
+    }
+
+    HardwareCounters::~HardwareCounters()
+    {
+        if (m_cacheMisses >= 0) { close(m_cacheMisses); }
+        if (m_branchMisses >= 0) { close(m_branchMisses); }
+        if (m_cycles >= 0) { close(m_cycles); }
+    }
+
+    bool HardwareCounters::Available() const
+    {
+        return m_cycles >= 0 && m_branchMisses >= 0 && m_cacheMisses >= 0;
+    }
+
+    void HardwareCounters::Start()
+    {
+        if (!Available()) { return; }
+        ioctl(m_cycles, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_cycles, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    void HardwareCounters::Stop(SolveStats& stats)
+    {
+        if (!Available()) { return; }
+        ioctl(m_cycles, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        stats.Cycles = ReadCounter(m_cycles);
+        stats.BranchMisses = ReadCounter(m_branchMisses);
+        stats.CacheMisses = ReadCounter(m_cacheMisses);
+    }
+#else
+    HardwareCounters::HardwareCounters()
+        : m_cycles(-1)
+        , m_branchMisses(-1)
+        , m_cacheMisses(-1)
+    {
+    }
+
+    HardwareCounters::~HardwareCounters()
+    {
+    }
+
+    bool HardwareCounters::Available() const
+    {
+        return false;
+    }
+
+    void HardwareCounters::Start()
+    {
+    }
+
+    void HardwareCounters::Stop(SolveStats&)
+    {
+    }
+#endif
+}
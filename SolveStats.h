@@ -0,0 +1,58 @@
+#pragma once
+
+//Set to 0 to compile every counter and timer out of the solver, the CMake option SUDOKU_STATS does this
+//SolveStats still exists so callers build either way, it just stays zeroed
+#ifndef SUDOKU_STATS
+#define SUDOKU_STATS 1
+#endif
+
+namespace Solver
+{
+	//What a single solve did, filled in when a solve is given somewhere to put it
+	struct SolveStats
+	{
+		long long Guesses = 0;
+		//Boards dropped off the stack because a guess under them failed
+		long long Backtracks = 0;
+		//Most boards on the stack at once, counting the starting board
+		int MaxDepth = 0;
+		//Queued singles SolveKnown worked through, including ones that were already placed
+		long long SolveKnownIterations = 0;
+		//Cells placed because they had one candidate left
+		long long Singles = 0;
+		//Cells placed because they were the last place for a digit in a unit
+		long long HiddenSingles = 0;
+		long long Copies = 0;
+		//Time placing singles and running deductions, and the rest of the solve on top of that
+		long long PropagationNs = 0;
+		long long SearchNs = 0;
+		//Hardware counters, only filled in by a HardwareCounters and left at -1 otherwise
+		long long Cycles = -1;
+		long long BranchMisses = -1;
+		long long CacheMisses = -1;
+	};
+
+	//Sums every counter, the maximum depth is the deepest of either
+	void AddStats(SolveStats& total, SolveStats const& part);
+
+	//Cycle, branch miss and cache miss counts for the calling thread through perf_event_open
+	//Only on Linux, and only when the kernel allows it, so check Available before relying on the numbers
+	class HardwareCounters
+	{
+	public:
+		HardwareCounters();
+		~HardwareCounters();
+		HardwareCounters(HardwareCounters const&) = delete;
+		HardwareCounters& operator=(HardwareCounters const&) = delete;
+
+		bool Available() const;
+		void Start();
+		//Writes what was counted since Start into the stats, leaves them alone when not available
+		void Stop(SolveStats& stats);
+
+	private:
+		int m_cycles;
+		int m_branchMisses;
+		int m_cacheMisses;
+	};
+}
@@ -0,0 +1,34 @@
+#include "Solver.h"
+#include "Board.h"
+
+namespace Solver
+{
+    template <int BoxSize>
+    SolveStatus SolvePuzzle(const char* in, char* out, BasicMoveStack<BoxSize>& boardStack,
+        BasicSolveOptions<BoxSize> const& options, SolveStats* stats) noexcept
+    {
+        using Board = BasicBoard<BoxSize>;
+        auto board = Board();
+        if (!Board::FromLine(in, board)) { return SolveStatus::InvalidInput; }
+
+        auto solution = Board();
+        auto guesses = 0;
+        const auto status = Solve<BoxSize>(board, solution, guesses, boardStack, options, nullptr, stats);
+        if (status == SolveStatus::Solved) { solution.ToLine(out); }
+        return status;
+    }
+
+    template <int BoxSize>
+    SolveStatus SolvePuzzle(const char* in, char* out, BasicSolveOptions<BoxSize> const& options, SolveStats* stats) noexcept
+    {
+        static thread_local BasicMoveStack<BoxSize> boardStack;
+        return SolvePuzzle<BoxSize>(in, out, boardStack, options, stats);
+    }
+
+    template SolveStatus SolvePuzzle<3>(const char*, char*, BasicMoveStack<3>&, BasicSolveOptions<3> const&, SolveStats*) noexcept;
+    template SolveStatus SolvePuzzle<3>(const char*, char*, BasicSolveOptions<3> const&, SolveStats*) noexcept;
+    template SolveStatus SolvePuzzle<4>(const char*, char*, BasicMoveStack<4>&, BasicSolveOptions<4> const&, SolveStats*) noexcept;
+    template SolveStatus SolvePuzzle<4>(const char*, char*, BasicSolveOptions<4> const&, SolveStats*) noexcept;
+    template SolveStatus SolvePuzzle<5>(const char*, char*, BasicMoveStack<5>&, BasicSolveOptions<5> const&, SolveStats*) noexcept;
+    template SolveStatus SolvePuzzle<5>(const char*, char*, BasicSolveOptions<5> const&, SolveStats*) noexcept;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "Board.h"
+
+namespace Solver
+{
+	//Entry points for embedding the solver in another program
+	//Nothing here prints, throws or touches the console, and any number of threads can solve at once
+
+	//Solve a puzzle of CellCount characters in row order, the same cells batch mode reads, with no length check
+	//A solution is written to out as CellCount characters with no terminator, out is left alone otherwise
+	//All the work happens in the given stack, so solving never allocates as long as each thread keeps its own
+	template <int BoxSize = 3>
+	SolveStatus SolvePuzzle(const char* in, char* out, BasicMoveStack<BoxSize>& boardStack,
+		BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>(), SolveStats* stats = nullptr) noexcept;
+	//Same again with a stack kept for the calling thread, allocated by the first solve on each thread
+	template <int BoxSize = 3>
+	SolveStatus SolvePuzzle(const char* in, char* out,
+		BasicSolveOptions<BoxSize> const& options = BasicSolveOptions<BoxSize>(), SolveStats* stats = nullptr) noexcept;
+}
@@ -0,0 +1,202 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Solver
+{
+    uint64_t PackRange(uint64_t begin, uint64_t end)
+    {
+        return (begin << 32) | end;
+    }
+
+    uint64_t RangeBegin(uint64_t range)
+    {
+        return range >> 32;
+    }
+
+    uint64_t RangeEnd(uint64_t range)
+    {
+        return range & 0xffffffffu;
+    }
+
+#ifdef __linux__
+    bool PinThread(pthread_t thread, int cpu)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        return pthread_setaffinity_np(thread, sizeof(cpus), &cpus) == 0;
+    }
+#endif
+
+    ThreadPool::ThreadPool(int threads)
+        : m_size(threads > 0 ? threads : std::max(1, (int)std::thread::hardware_concurrency()))
+        , m_job(nullptr)
+        , m_generation(0)
+        , m_busy(0)
+        , m_stop(false)
+    {
+        m_slices.reset(new Slice[m_size]);
+        for (auto i = 0; i < m_size; ++i)
+        {
+            m_slices[i].Range.store(0);
+        }
+
+        //Worker 0 is whoever calls ParallelFor
+        for (auto i = 1; i < m_size; ++i)
+        {
+            m_threads.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    int ThreadPool::Size() const
+    {
+        return m_size;
+    }
+
+    bool ThreadPool::PinThreads()
+    {
+#ifdef __linux__
+        const auto cpus = std::max(1, (int)std::thread::hardware_concurrency());
+        auto pinned = PinThread(pthread_self(), 0);
+        for (size_t i = 0; i < m_threads.size(); ++i)
+        {
+            pinned = PinThread(m_threads[i].native_handle(), (int)(i + 1) % cpus) && pinned;
+        }
+        return pinned;
+#else
+        return false;
+#endif
+    }
+
+    void ThreadPool::ParallelFor(size_t count, Job const& job)
+    {
+        if (count == 0) { return; }
+
+        //Hand out equal slices up front, stealing evens out whatever imbalance is left
+        for (auto i = 0; i < m_size; ++i)
+        {
+            const auto begin = count * i / m_size;
+            const auto end = count * (i + 1) / m_size;
+            m_slices[i].Range.store(PackRange(begin, end), std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &job;
+            m_busy = m_size - 1;
+            m_generation += 1;
+        }
+        m_wake.notify_all();
+
+        RunSlices(0);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_busy == 0; });
+        m_job = nullptr;
+    }
+
+    //Sleep until there is a new job, run it, then report back
+    void ThreadPool::WorkerLoop(int worker)
+    {
+        uint64_t seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) { return; }
+                seen = m_generation;
+            }
+
+            RunSlices(worker);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busy == 0) { m_done.notify_one(); }
+        }
+    }
+
+    void ThreadPool::RunSlices(int worker)
+    {
+        auto const& job = *m_job;
+        size_t index;
+        do
+        {
+            while (TakeOwn(worker, index))
+            {
+                job(worker, index);
+            }
+        } while (Steal(worker));
+    }
+
+    //Take the next index from the front of our own slice
+    bool ThreadPool::TakeOwn(int worker, size_t& index)
+    {
+        auto& range = m_slices[worker].Range;
+        auto current = range.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const auto begin = RangeBegin(current);
+            const auto end = RangeEnd(current);
+            if (begin >= end) { return false; }
+
+            if (range.compare_exchange_weak(current, PackRange(begin + 1, end), std::memory_order_acq_rel))
+            {
+                index = (size_t)begin;
+                return true;
+            }
+        }
+    }
+
+    //Move the back half of the busiest slice into our own, which is empty by now
+    //Returns false once every slice is empty
+    bool ThreadPool::Steal(int worker)
+    {
+        for (;;)
+        {
+            auto victim = -1;
+            uint64_t victimRange = 0;
+            uint64_t most = 0;
+            for (auto i = 0; i < m_size; ++i)
+            {
+                if (i == worker) { continue; }
+                const auto range = m_slices[i].Range.load(std::memory_order_acquire);
+                const auto remaining = RangeEnd(range) - std::min(RangeBegin(range), RangeEnd(range));
+                if (remaining > most)
+                {
+                    most = remaining;
+                    victim = i;
+                    victimRange = range;
+                }
+            }
+            if (victim < 0) { return false; }
+
+            const auto begin = RangeBegin(victimRange);
+            const auto end = RangeEnd(victimRange);
+            const auto split = end - (end - begin + 1) / 2;
+            if (m_slices[victim].Range.compare_exchange_strong(victimRange, PackRange(begin, split), std::memory_order_acq_rel))
+            {
+                m_slices[worker].Range.store(PackRange(split, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Solver
+{
+	//Fixed set of workers for running indexed jobs across all cores
+	//The calling thread takes part as worker 0, so a pool of one runs everything inline
+	class ThreadPool
+	{
+	public:
+		using Job = std::function<void(int worker, size_t index)>;
+
+		//A thread count of zero uses every hardware thread
+		explicit ThreadPool(int threads);
+		~ThreadPool();
+
+		int Size() const;
+
+		//Keep worker i on logical CPU i, wrapping round when there are more workers than CPUs
+		//Worker 0 is the calling thread, so it stays pinned after the pool is gone
+		//Returns false where pinning isn't supported or wasn't allowed, the pool works the same either way
+		bool PinThreads();
+
+		//Run job for every index in [0, count) and return once all of them are done
+		//Each worker starts on its own slice, and once it runs dry it steals half of the busiest slice
+		//That way a slow index only delays the worker running it, the rest of its slice moves on
+		void ParallelFor(size_t count, Job const& job);
+
+	private:
+		//A slice is a [begin, end) range packed in one word so taking and stealing are single CAS operations
+		//Padded to a cache line so workers don't fight over each others slices
+		struct Slice
+		{
+			std::atomic<uint64_t> Range;
+			char Padding[64 - sizeof(std::atomic<uint64_t>)];
+		};
+
+		void WorkerLoop(int worker);
+		void RunSlices(int worker);
+		bool TakeOwn(int worker, size_t& index);
+		bool Steal(int worker);
+
+		std::vector<std::thread> m_threads;
+		std::unique_ptr<Slice[]> m_slices;
+		int m_size;
+
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+		Job const* m_job;
+		uint64_t m_generation;
+		int m_busy;
+		bool m_stop;
+	};
+}
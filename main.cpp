@@ -1,21 +1,700 @@
-#include <stdio.h>
-#include <chrono>
-#include "Board.h"
-
-int main(int argc, char* argv[])
-{
-    auto boardNum = 0;
-    if (argc > 1)
-    {
-        boardNum = atoi(argv[argc - 1]);
-    }
-
-    auto board = Solver::Board::GetBoard(boardNum);
-
-    const auto begin = std::chrono::high_resolution_clock::now();
-    Solver::SolveBoard(board);
-    const auto end = std::chrono::high_resolution_clock::now();
-
-    printf("Completed in %gs\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() / 1e3);
-    return 0;
-}
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "Batch.h"
+#include "Board.h"
+#include "FileIo.h"
+#include "Generator.h"
+#include "ParallelSolver.h"
+#include "PuzzleFile.h"
+#include "Renderer.h"
+#include "Server.h"
+#include "ShardRunner.h"
+#include "SolutionCache.h"
+#include "ThreadPool.h"
+
+//Visual modes redraw at this rate at most so drawing doesn't dominate the solve time
+static const auto RenderFps = 30;
+
+//Solver settings from the command line, turned into options once the size of the grid is known
+struct SolverSettings
+{
+    Solver::Branching Branching = Solver::Branching::MinimumRemaining;
+    unsigned int Deductions = Solver::DefaultDeductions;
+    int SolutionLimit = 1;
+    Solver::Engine Engine = Solver::Engine::Masks;
+    //Puzzles batch mode remembers by canonical form, 0 turns the cache off
+    size_t CacheSize = 0;
+    //Budgets for each puzzle, 0 for no limit
+    int GuessLimit = 0;
+    int TimeLimitMs = 0;
+};
+
+template <int BoxSize>
+Solver::BasicSolveOptions<BoxSize> MakeOptions(SolverSettings const& settings)
+{
+    auto options = Solver::BasicSolveOptions<BoxSize>();
+    options.Strategy = &Solver::GetBranchStrategy<BoxSize>(settings.Branching);
+    options.Deductions = settings.Deductions;
+    options.SolutionLimit = settings.SolutionLimit;
+    options.Engine = settings.Engine;
+    options.GuessLimit = settings.GuessLimit;
+    options.TimeLimitMs = settings.TimeLimitMs;
+    return options;
+}
+
+//Solve, print how it went and hand back the stats, drawing through the observer if there is one
+Solver::SolveStats SolveBoard(Solver::Board const& board, Solver::BoardObserver* observer)
+{
+    auto solution = Solver::Board();
+    auto guesses = 0;
+    auto stats = Solver::SolveStats();
+    Solver::MoveStack boardStack;
+    const auto status = Solver::Solve(board, solution, guesses, boardStack, Solver::SolveOptions(), observer, &stats);
+
+    switch (status)
+    {
+    case Solver::SolveStatus::InvalidInput:
+        printf("Invalid input\n");
+        break;
+    case Solver::SolveStatus::Unsolvable:
+        printf("Failed to solve board after %d guesses\n", guesses);
+        break;
+    case Solver::SolveStatus::Solved:
+        printf("Solved board after %d guesses\n", guesses);
+        break;
+    case Solver::SolveStatus::Cancelled:
+        printf("Stopped after %d guesses\n", guesses);
+        break;
+    case Solver::SolveStatus::BudgetExceeded:
+        printf("Ran out of budget after %d guesses\n", guesses);
+        break;
+    }
+    if (SUDOKU_STATS && status != Solver::SolveStatus::InvalidInput)
+    {
+        printf("%lld backtracks, depth %d, %lld singles and %lld hidden singles placed, %lld boards copied\n",
+            stats.Backtracks, stats.MaxDepth, stats.Singles, stats.HiddenSingles, stats.Copies);
+    }
+    return stats;
+}
+
+//Headless mode: solve every line of a file (or stdin) without touching the console
+//A single thread streams line by line, more than that solves blocks of lines across a pool
+//Results go to stdout, or to outPath when there is one, as lines or as a binary file of solutions
+template <int BoxSize>
+int RunBatch(const char* path, const char* outPath, Solver::BatchFormat format, int threads, SolverSettings const& settings)
+{
+    auto options = MakeOptions<BoxSize>(settings);
+    std::unique_ptr<Solver::BasicSolutionCache<BoxSize>> cache;
+    if (settings.CacheSize > 0)
+    {
+        cache.reset(new Solver::BasicSolutionCache<BoxSize>(settings.CacheSize));
+        options.Cache = cache.get();
+    }
+    const auto binary = format == Solver::BatchFormat::Binary;
+    const auto header = Solver::MakeBinaryHeader<BoxSize>(true);
+    char headerBytes[Solver::BinaryHeader::Size];
+    Solver::WriteBinaryHeader(header, headerBytes);
+
+    std::ios::sync_with_stdio(false);
+
+    //Regular files are mapped and parsed in place, anything else such as stdin or a pipe is streamed
+    const auto named = path != nullptr && strcmp(path, "-") != 0;
+    Solver::MappedFile mapped;
+    std::ifstream file;
+    if (named && !mapped.Open(path))
+    {
+        file.open(path);
+        if (!file)
+        {
+            fprintf(stderr, "Unable to open %s\n", path);
+            return 1;
+        }
+    }
+    auto& in = file.is_open() ? static_cast<std::istream&>(file) : std::cin;
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    Solver::ThreadPool pool(threads);
+    auto summary = Solver::BatchSummary();
+    auto written = false;
+    if (named && !file.is_open())
+    {
+        auto output = outPath != nullptr ? fopen(outPath, "wb") : stdout;
+        if (output == nullptr)
+        {
+            fprintf(stderr, "Unable to create %s\n", outPath);
+            return 1;
+        }
+        {
+            Solver::BufferedWriter out(output);
+            if (binary) { out.Write(headerBytes, sizeof(headerBytes)); }
+            summary = (pool.Size() == 1)
+                ? Solver::SolveBuffer(mapped.Data(), mapped.Size(), out, options, format)
+                : Solver::SolveBuffer(mapped.Data(), mapped.Size(), out, pool, options, format);
+            written = out.Flush();
+        }
+        if (output != stdout) { written = fclose(output) == 0 && written; }
+    }
+    else
+    {
+        std::ofstream outFile;
+        if (outPath != nullptr)
+        {
+            outFile.open(outPath, std::ios::binary);
+            if (!outFile)
+            {
+                fprintf(stderr, "Unable to create %s\n", outPath);
+                return 1;
+            }
+        }
+        auto& out = outFile.is_open() ? static_cast<std::ostream&>(outFile) : std::cout;
+        if (binary) { out.write(headerBytes, sizeof(headerBytes)); }
+        summary = (pool.Size() == 1) ? Solver::SolveStream(in, out, options, format) : Solver::SolveStream(in, out, pool, options, format);
+        out.flush();
+        written = !out.fail();
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    //Output cut short by a full disk or a closed pipe must not look like a finished run
+    if (!written)
+    {
+        fprintf(stderr, "Unable to write %s\n", outPath != nullptr ? outPath : "to stdout");
+        return 1;
+    }
+
+    //A binary file written to stdout keeps the unknown count, readers work it out from the size instead
+    if (binary && outPath != nullptr)
+    {
+        auto output = fopen(outPath, "r+b");
+        if (output == nullptr || !Solver::FinishBinaryFile(output, header, (uint64_t)summary.Puzzles))
+        {
+            fprintf(stderr, "Unable to write the record count to %s\n", outPath);
+        }
+        if (output != nullptr) { fclose(output); }
+    }
+
+    const auto seconds = std::chrono::duration<double>(end - begin).count();
+    fprintf(stderr, "%lld puzzles (%lld solved, %lld unsolvable, %lld invalid), %lld guesses in %gs on %d threads\n",
+        summary.Puzzles, summary.Solved, summary.Unsolvable, summary.Invalid, summary.Guesses, seconds, pool.Size());
+    if (summary.Stopped > 0)
+    {
+        fprintf(stderr, "%lld stopped by the guess or time limit\n", summary.Stopped);
+    }
+    if (options.SolutionLimit > 1)
+    {
+        fprintf(stderr, "%lld unique, %lld with more than one solution\n", summary.Solved - summary.Multiple, summary.Multiple);
+    }
+    if (cache)
+    {
+        const auto stats = cache->Stats();
+        fprintf(stderr, "Cache: %lld lookups, %lld hits (%.1f%%), %lld skipped, %lld evictions, %.2fus per lookup\n",
+            stats.Lookups, stats.Hits, stats.Lookups > 0 ? 100.0 * stats.Hits / stats.Lookups : 0.0, stats.Skipped, stats.Evictions,
+            stats.Lookups > 0 ? stats.LookupNs / 1000.0 / stats.Lookups : 0.0);
+    }
+    return 0;
+}
+
+//Server mode: answer puzzles with IDs from stdin, or from every client of a Unix domain socket until interrupted
+template <int BoxSize>
+int RunServe(const char* socketPath, Solver::ServerSettings const& serverSettings, SolverSettings const& settings)
+{
+    auto options = MakeOptions<BoxSize>(settings);
+    std::unique_ptr<Solver::BasicSolutionCache<BoxSize>> cache;
+    if (settings.CacheSize > 0)
+    {
+        cache.reset(new Solver::BasicSolutionCache<BoxSize>(settings.CacheSize));
+        options.Cache = cache.get();
+    }
+
+    auto summary = Solver::ServerSummary();
+    if (socketPath == nullptr) { summary = Solver::ServeStream<BoxSize>(0, 1, options, serverSettings); }
+    else
+    {
+        signal(SIGINT, [](int) { Solver::StopServer(); });
+        signal(SIGTERM, [](int) { Solver::StopServer(); });
+        fprintf(stderr, "Serving on %s\n", socketPath);
+        if (!Solver::ServeSocket<BoxSize>(socketPath, options, serverSettings, summary))
+        {
+            fprintf(stderr, "Unable to serve on %s\n", socketPath);
+            return 1;
+        }
+    }
+
+    fprintf(stderr, "%lld requests (%lld solved, %lld unsolvable, %lld invalid, %lld timed out, %lld stopped), latency p50 %.0fus p99 %.0fus max %.0fus\n",
+        summary.Requests, summary.Solved, summary.Unsolvable, summary.Invalid, summary.Timeouts, summary.Stopped, summary.P50Us,
+        summary.P99Us, summary.MaxUs);
+    if (cache)
+    {
+        const auto stats = cache->Stats();
+        fprintf(stderr, "Cache: %lld lookups, %lld hits (%.1f%%)\n", stats.Lookups, stats.Hits,
+            stats.Lookups > 0 ? 100.0 * stats.Hits / stats.Lookups : 0.0);
+    }
+    return 0;
+}
+
+//Sharded mode: split a corpus over worker processes, each running batch mode on its shard, and merge their results in order
+//A run that is stopped picks up from its checkpoint when started again with the same files
+int RunSharded(const char* path, const char* outPath, const char* checkpointPath, Solver::ShardSettings const& settings)
+{
+    if (path == nullptr || outPath == nullptr)
+    {
+        fprintf(stderr, "Expected --sharded FILE --out FILE\n");
+        return 1;
+    }
+    const auto checkpoint = checkpointPath != nullptr ? std::string(checkpointPath) : std::string(outPath) + ".checkpoint";
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    auto summary = Solver::ShardSummary();
+    const auto finished = Solver::RunShards(path, outPath, checkpoint.c_str(), settings, summary);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    if (!finished && summary.Puzzles == 0)
+    {
+        fprintf(stderr, "%s\n", summary.Failure.c_str());
+        return 1;
+    }
+    const auto seconds = std::chrono::duration<double>(end - begin).count();
+    fprintf(stderr, "%lld puzzles (%lld solved, %lld unsolvable, %lld invalid, %lld stopped), %lld shards in %gs, %lld resumed, %lld retries\n",
+        summary.Puzzles, summary.Solved, summary.Unsolvable, summary.Invalid, summary.Stopped, summary.Shards, seconds, summary.Resumed,
+        summary.Retries);
+    if (!finished)
+    {
+        fprintf(stderr, "%s, progress is saved in %s for the next run to resume from\n", summary.Failure.c_str(), checkpoint.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+//Convert a puzzle file between text lines and the binary format, in whichever direction isn't the format it's in now
+template <int BoxSize>
+int RunConvert(const char* inPath, const char* outPath, bool toBinary)
+{
+    Solver::MappedFile mapped;
+    if (!mapped.Open(inPath))
+    {
+        fprintf(stderr, "Unable to open %s\n", inPath);
+        return 1;
+    }
+    auto output = fopen(outPath, "wb");
+    if (output == nullptr)
+    {
+        fprintf(stderr, "Unable to create %s\n", outPath);
+        return 1;
+    }
+
+    auto count = 0ll;
+    auto header = Solver::BinaryHeader();
+    auto written = false;
+    {
+        Solver::BufferedWriter out(output);
+        count = toBinary
+            ? Solver::TextToBinary<BoxSize>(mapped.Data(), mapped.Size(), out, header)
+            : Solver::BinaryToText<BoxSize>(mapped.Data(), mapped.Size(), out);
+        written = out.Flush();
+    }
+    if (toBinary && written) { written = Solver::FinishBinaryFile(output, header, (uint64_t)count); }
+    const auto size = ftell(output);
+    fclose(output);
+
+    if (count < 0)
+    {
+        fprintf(stderr, "%s isn't a binary puzzle file\n", inPath);
+        return 1;
+    }
+    if (!written)
+    {
+        fprintf(stderr, "Unable to write %s\n", outPath);
+        return 1;
+    }
+    fprintf(stderr, "%lld puzzles, %zu bytes to %ld bytes\n", count, mapped.Size(), size);
+    return 0;
+}
+
+//Visual mode for any terminal: solve a single puzzle line and draw it with escape codes
+int RunAnsi(const char* puzzle)
+{
+    std::string line;
+    if (puzzle != nullptr) { line = puzzle; }
+    else { std::getline(std::cin, line); }
+
+    auto board = Solver::Board();
+    if (!Solver::Board::FromLine(line, board))
+    {
+        fprintf(stderr, "Expected 81 cells using 1-9 and . or 0 for blanks\n");
+        return 1;
+    }
+
+    auto renderer = Solver::AnsiRenderer(stdout, RenderFps);
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    SolveBoard(board, &renderer);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    printf("Completed in %gs\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() / 1e3);
+    return 0;
+}
+
+//Split the search for one puzzle across threads, for hard puzzles that need a low latency answer
+template <int BoxSize>
+int RunParallel(const char* puzzle, int threads, SolverSettings const& settings)
+{
+    using Board = Solver::BasicBoard<BoxSize>;
+    std::string line;
+    if (puzzle != nullptr) { line = puzzle; }
+    else { std::getline(std::cin, line); }
+
+    auto board = Board();
+    if (!Board::FromLine(line, board))
+    {
+        fprintf(stderr, "Expected %d cells using 1-9, then A onwards, and . or 0 for blanks\n", Board::CellCount);
+        return 1;
+    }
+
+    Solver::ThreadPool pool(threads);
+    auto solution = Board();
+    auto guesses = 0;
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    const auto status = Solver::SolveParallel(board, solution, guesses, pool, MakeOptions<BoxSize>(settings));
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    if (status == Solver::SolveStatus::Solved)
+    {
+        char solutionLine[Board::CellCount + 1] = {};
+        solution.ToLine(solutionLine);
+        printf("%s\n", solutionLine);
+    }
+    else
+    {
+        switch (status)
+        {
+        case Solver::SolveStatus::InvalidInput: printf("invalid\n"); break;
+        case Solver::SolveStatus::BudgetExceeded: printf("exceeded\n"); break;
+        case Solver::SolveStatus::Cancelled: printf("cancelled\n"); break;
+        default: printf("unsolvable\n"); break;
+        }
+    }
+    fprintf(stderr, "%d guesses in %gs on %d threads\n", guesses, std::chrono::duration<double>(end - begin).count(), pool.Size());
+    return 0;
+}
+
+//Write count fresh puzzles with a single solution each to stdout, spread over the pool
+template <int BoxSize>
+int RunGenerate(long long count, int threads, Solver::GenerateOptions const& options)
+{
+    std::ios::sync_with_stdio(false);
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    Solver::ThreadPool pool(threads);
+    const auto summary = Solver::Generate<BoxSize>(std::cout, count, pool, options);
+    std::cout.flush();
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    const auto seconds = std::chrono::duration<double>(end - begin).count();
+    fprintf(stderr, "%lld puzzles (%g clues on average, %lld above target) from %lld grids, %lld uniqueness checks, %lld guesses in %gs on %d threads\n",
+        summary.Puzzles, summary.Puzzles > 0 ? (double)summary.Clues / summary.Puzzles : 0.0, summary.AboveTarget,
+        summary.Grids, summary.Checks, summary.Guesses, seconds, pool.Size());
+    fprintf(stderr, "%.1f puzzles/s\n", seconds > 0 ? summary.Puzzles / seconds : 0.0);
+    return 0;
+}
+
+//Reads the value of --branch into the settings, returns false if the name isn't known
+bool ParseBranchOption(const char* name, SolverSettings& settings)
+{
+    if (!Solver::ParseBranching(name, settings.Branching))
+    {
+        fprintf(stderr, "Unknown branching %s, expected first, mrv, degree or lcv\n", name);
+        return false;
+    }
+    return true;
+}
+
+//Reads the value of --engine into the settings, returns false if the name isn't known
+bool ParseEngineOption(const char* name, SolverSettings& settings)
+{
+    if (!Solver::ParseEngine(name, settings.Engine))
+    {
+        fprintf(stderr, "Unknown engine %s, expected masks, bitboard or dlx\n", name);
+        return false;
+    }
+    return true;
+}
+
+//Reads the value of --deduce into the settings, returns false if any name isn't known
+bool ParseDeduceOption(const char* names, SolverSettings& settings)
+{
+    if (!Solver::ParseDeductions(names, settings.Deductions))
+    {
+        fprintf(stderr, "Unknown deductions %s, expected all, none or a comma separated list of "
+            "naked2, naked3, hidden2, hidden3, pointing, boxline, xwing and swordfish\n", names);
+        return false;
+    }
+    return true;
+}
+
+//Reads the value of --size, the number of cells on a side, returns false for sizes without code compiled in
+bool ParseSizeOption(const char* value, int& boxSize)
+{
+    const auto size = atoi(value);
+    if (size != 9 && size != 16 && size != 25)
+    {
+        fprintf(stderr, "Unsupported size %s, expected 9, 16 or 25\n", value);
+        return false;
+    }
+    boxSize = size == 9 ? 3 : size == 16 ? 4 : 5;
+    return true;
+}
+
+//Reads the value of --format, text or binary
+bool ParseFormatOption(const char* name, Solver::BatchFormat& format)
+{
+    if (strcmp(name, "text") == 0) { format = Solver::BatchFormat::Text; }
+    else if (strcmp(name, "binary") == 0) { format = Solver::BatchFormat::Binary; }
+    else
+    {
+        fprintf(stderr, "Unknown format %s, expected text or binary\n", name);
+        return false;
+    }
+    return true;
+}
+
+//Takes the box size from the header when path is a binary puzzle file, and leaves it alone for anything else
+void ReadBinaryBoxSize(const char* path, int& boxSize)
+{
+    auto file = path != nullptr ? fopen(path, "rb") : nullptr;
+    if (file == nullptr) { return; }
+
+    char bytes[Solver::BinaryHeader::Size];
+    auto header = Solver::BinaryHeader();
+    if (fread(bytes, 1, sizeof(bytes), file) == sizeof(bytes) && Solver::ReadBinaryHeader(bytes, sizeof(bytes), header)
+        && header.BoxSize >= 3 && header.BoxSize <= 5)
+    {
+        boxSize = header.BoxSize;
+    }
+    fclose(file);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0)
+    {
+        const char* path = nullptr;
+        const char* outPath = nullptr;
+        auto format = Solver::BatchFormat::Text;
+        auto threads = 0;
+        auto boxSize = 3;
+        auto settings = SolverSettings();
+        for (auto i = 2; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { threads = atoi(argv[++i]); }
+            else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) { if (!ParseSizeOption(argv[++i], boxSize)) { return 1; } }
+            else if (strcmp(argv[i], "--branch") == 0 && i + 1 < argc) { if (!ParseBranchOption(argv[++i], settings)) { return 1; } }
+            else if (strcmp(argv[i], "--deduce") == 0 && i + 1 < argc) { if (!ParseDeduceOption(argv[++i], settings)) { return 1; } }
+            else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) { if (!ParseEngineOption(argv[++i], settings)) { return 1; } }
+            else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) { settings.SolutionLimit = std::max(2, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) { settings.CacheSize = (size_t)std::max(0, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--guess-limit") == 0 && i + 1 < argc) { settings.GuessLimit = std::max(0, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc) { settings.TimeLimitMs = std::max(0, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) { outPath = argv[++i]; }
+            else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) { if (!ParseFormatOption(argv[++i], format)) { return 1; } }
+            else if (argv[i][0] != '-' || strcmp(argv[i], "-") == 0) { path = argv[i]; }
+            else
+            {
+                fprintf(stderr, "Unknown option %s\n", argv[i]);
+                return 1;
+            }
+        }
+        //A binary file says what size its puzzles are
+        ReadBinaryBoxSize(path, boxSize);
+        switch (boxSize)
+        {
+        case 4: return RunBatch<4>(path, outPath, format, threads, settings);
+        case 5: return RunBatch<5>(path, outPath, format, threads, settings);
+        default: return RunBatch<3>(path, outPath, format, threads, settings);
+        }
+    }
+    if (argc > 1 && strcmp(argv[1], "--serve") == 0)
+    {
+        const char* socketPath = nullptr;
+        auto boxSize = 3;
+        auto settings = SolverSettings();
+        auto serverSettings = Solver::ServerSettings();
+        for (auto i = 2; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) { socketPath = argv[++i]; }
+            else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { serverSettings.Threads = atoi(argv[++i]); }
+            else if (strcmp(argv[i], "--queue") == 0 && i + 1 < argc) { serverSettings.QueueLimit = (size_t)std::max(1, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--deadline") == 0 && i + 1 < argc) { serverSettings.DeadlineMs = std::max(0, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) { if (!ParseSizeOption(argv[++i], boxSize)) { return 1; } }
+            else if (strcmp(argv[i], "--branch") == 0 && i + 1 < argc) { if (!ParseBranchOption(argv[++i], settings)) { return 1; } }
+            else if (strcmp(argv[i], "--deduce") == 0 && i + 1 < argc) { if (!ParseDeduceOption(argv[++i], settings)) { return 1; } }
+            else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) { if (!ParseEngineOption(argv[++i], settings)) { return 1; } }
+            else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) { settings.SolutionLimit = std::max(2, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) { settings.CacheSize = (size_t)std::max(0, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--guess-limit") == 0 && i + 1 < argc) { settings.GuessLimit = std::max(0, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc) { settings.TimeLimitMs = std::max(0, atoi(argv[++i])); }
+            else
+            {
+                fprintf(stderr, "Unknown option %s\n", argv[i]);
+                return 1;
+            }
+        }
+        switch (boxSize)
+        {
+        case 4: return RunServe<4>(socketPath, serverSettings, settings);
+        case 5: return RunServe<5>(socketPath, serverSettings, settings);
+        default: return RunServe<3>(socketPath, serverSettings, settings);
+        }
+    }
+    if (argc > 1 && strcmp(argv[1], "--sharded") == 0)
+    {
+        const char* path = nullptr;
+        const char* outPath = nullptr;
+        const char* checkpointPath = nullptr;
+        auto boxSize = 3;
+        auto settings = SolverSettings();
+        auto shardSettings = Solver::ShardSettings();
+        //Workers are this program in batch mode, given the solver options as they were passed here
+        shardSettings.WorkerCommand = { argv[0], "--batch", "-", "--threads", "1" };
+        for (auto i = 2; i < argc; ++i)
+        {
+            const auto forwarded = i;
+            if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) { outPath = argv[++i]; }
+            else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) { checkpointPath = argv[++i]; }
+            else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) { shardSettings.Workers = atoi(argv[++i]); }
+            else if (strcmp(argv[i], "--shard-size") == 0 && i + 1 < argc) { shardSettings.ShardSize = atoll(argv[++i]); }
+            else if (argv[i][0] != '-' || strcmp(argv[i], "-") == 0) { path = argv[i]; }
+            else if (i + 1 >= argc)
+            {
+                fprintf(stderr, "Unknown option %s\n", argv[i]);
+                return 1;
+            }
+            else
+            {
+                //Solver options are checked here so a typo fails now rather than in every worker
+                if (strcmp(argv[i], "--size") == 0) { if (!ParseSizeOption(argv[++i], boxSize)) { return 1; } }
+                else if (strcmp(argv[i], "--branch") == 0) { if (!ParseBranchOption(argv[++i], settings)) { return 1; } }
+                else if (strcmp(argv[i], "--deduce") == 0) { if (!ParseDeduceOption(argv[++i], settings)) { return 1; } }
+                else if (strcmp(argv[i], "--engine") == 0) { if (!ParseEngineOption(argv[++i], settings)) { return 1; } }
+                else if (strcmp(argv[i], "--count") == 0 || strcmp(argv[i], "--cache") == 0 || strcmp(argv[i], "--guess-limit") == 0
+                    || strcmp(argv[i], "--time-limit") == 0) { ++i; }
+                else
+                {
+                    fprintf(stderr, "Unknown option %s\n", argv[i]);
+                    return 1;
+                }
+                shardSettings.WorkerCommand.push_back(argv[forwarded]);
+                shardSettings.WorkerCommand.push_back(argv[forwarded + 1]);
+            }
+        }
+        return RunSharded(path, outPath, checkpointPath, shardSettings);
+    }
+    if (argc > 1 && (strcmp(argv[1], "--to-binary") == 0 || strcmp(argv[1], "--to-text") == 0))
+    {
+        const auto toBinary = strcmp(argv[1], "--to-binary") == 0;
+        const char* paths[2] = {};
+        auto pathCount = 0;
+        auto boxSize = 3;
+        for (auto i = 2; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) { if (!ParseSizeOption(argv[++i], boxSize)) { return 1; } }
+            else if (pathCount < 2) { paths[pathCount++] = argv[i]; }
+        }
+        if (pathCount < 2)
+        {
+            fprintf(stderr, "Expected %s INPUT OUTPUT\n", argv[1]);
+            return 1;
+        }
+        if (!toBinary) { ReadBinaryBoxSize(paths[0], boxSize); }
+        switch (boxSize)
+        {
+        case 4: return RunConvert<4>(paths[0], paths[1], toBinary);
+        case 5: return RunConvert<5>(paths[0], paths[1], toBinary);
+        default: return RunConvert<3>(paths[0], paths[1], toBinary);
+        }
+    }
+    if (argc > 1 && strcmp(argv[1], "--parallel") == 0)
+    {
+        const char* puzzle = nullptr;
+        auto threads = 0;
+        auto boxSize = 3;
+        auto settings = SolverSettings();
+        for (auto i = 2; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { threads = atoi(argv[++i]); }
+            else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) { if (!ParseSizeOption(argv[++i], boxSize)) { return 1; } }
+            else if (strcmp(argv[i], "--branch") == 0 && i + 1 < argc) { if (!ParseBranchOption(argv[++i], settings)) { return 1; } }
+            else if (strcmp(argv[i], "--deduce") == 0 && i + 1 < argc) { if (!ParseDeduceOption(argv[++i], settings)) { return 1; } }
+            else if (strcmp(argv[i], "--guess-limit") == 0 && i + 1 < argc) { settings.GuessLimit = std::max(0, atoi(argv[++i])); }
+            else if (strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc) { settings.TimeLimitMs = std::max(0, atoi(argv[++i])); }
+            else { puzzle = argv[i]; }
+        }
+        switch (boxSize)
+        {
+        case 4: return RunParallel<4>(puzzle, threads, settings);
+        case 5: return RunParallel<5>(puzzle, threads, settings);
+        default: return RunParallel<3>(puzzle, threads, settings);
+        }
+    }
+    if (argc > 1 && strcmp(argv[1], "--generate") == 0)
+    {
+        long long count = 1;
+        auto threads = 0;
+        auto boxSize = 3;
+        auto options = Solver::GenerateOptions();
+        for (auto i = 2; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { threads = atoi(argv[++i]); }
+            else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) { if (!ParseSizeOption(argv[++i], boxSize)) { return 1; } }
+            else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) { options.Seed = strtoull(argv[++i], nullptr, 10); }
+            else if (strcmp(argv[i], "--clues") == 0 && i + 1 < argc) { options.TargetClues = atoi(argv[++i]); }
+            else if (strcmp(argv[i], "--attempts") == 0 && i + 1 < argc) { options.Attempts = atoi(argv[++i]); }
+            else if (strcmp(argv[i], "--symmetry") == 0 && i + 1 < argc)
+            {
+                if (!Solver::ParseSymmetry(argv[++i], options.Symmetry))
+                {
+                    fprintf(stderr, "Unknown symmetry %s, expected none, rotational, mirror or diagonal\n", argv[i]);
+                    return 1;
+                }
+            }
+            else { count = atoll(argv[i]); }
+        }
+        switch (boxSize)
+        {
+        case 4: return RunGenerate<4>(count, threads, options);
+        case 5: return RunGenerate<5>(count, threads, options);
+        default: return RunGenerate<3>(count, threads, options);
+        }
+    }
+    if (argc > 1 && strcmp(argv[1], "--ansi") == 0)
+    {
+        return RunAnsi(argc > 2 ? argv[2] : nullptr);
+    }
+
+#ifdef _WIN32
+    auto boardNum = 0;
+    if (argc > 1)
+    {
+        boardNum = atoi(argv[argc - 1]);
+    }
+
+    auto board = Solver::ReadConsoleBoard(boardNum);
+    auto renderer = Solver::ConsoleRenderer(RenderFps);
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    SolveBoard(board, &renderer);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    printf("Completed in %gs\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() / 1e3);
+    return 0;
+#else
+    //The interactive console needs Windows, everywhere else read the puzzle from the command line or stdin
+    return RunAnsi(argc > 1 ? argv[argc - 1] : nullptr);
+#endif
+}